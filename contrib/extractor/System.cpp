@@ -282,11 +282,28 @@ void ReadLiquidTypeTableDBC()
 
 // Map file format data
 static char const* MAP_MAGIC         = "MAPS";
-static char const* MAP_VERSION_MAGIC = "v1.3";
+static char const* MAP_VERSION_MAGIC = "v1.4";
 static char const* MAP_AREA_MAGIC    = "AREA";
 static char const* MAP_HEIGHT_MAGIC  = "MHGT";
 static char const* MAP_LIQUID_MAGIC  = "MLIQ";
 
+// v1.4: every section starts at a multiple of MAP_SECTION_ALIGN, so the server can use the arrays in place from a memory mapping
+#define MAP_SECTION_ALIGN 16
+
+static uint32 alignSection(uint32 offset)
+{
+    return (offset + MAP_SECTION_ALIGN - 1) & ~uint32(MAP_SECTION_ALIGN - 1);
+}
+
+// zero fill up to the start of the next section
+static void writeSectionPadding(FILE* output, uint32 offset)
+{
+    static char const padding[MAP_SECTION_ALIGN] = {};
+    long pos = ftell(output);
+    if (pos < long(offset))
+        fwrite(padding, offset - pos, 1, output);
+}
+
 struct map_fileheader
 {
     uint32 mapMagic;
@@ -431,7 +448,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
         }
     }
 
-    map.areaMapOffset = sizeof(map);
+    map.areaMapOffset = alignSection(sizeof(map));
     map.areaMapSize   = sizeof(map_areaHeader);
 
     map_areaHeader areaHeader;
@@ -560,7 +577,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
             maxHeight = CONF_use_minHeight;
     }
 
-    map.heightMapOffset = map.areaMapOffset + map.areaMapSize;
+    map.heightMapOffset = alignSection(map.areaMapOffset + map.areaMapSize);
     map.heightMapSize = sizeof(map_heightHeader);
 
     map_heightHeader heightHeader;
@@ -803,7 +820,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
                     liquid_height[y][x] = CONF_use_minHeight;
             }
         }
-        map.liquidMapOffset = map.heightMapOffset + map.heightMapSize;
+        map.liquidMapOffset = alignSection(map.heightMapOffset + map.heightMapSize);
         map.liquidMapSize = sizeof(map_liquidHeader);
         liquidHeader.fourcc = *(uint32 const*)MAP_LIQUID_MAGIC;
         liquidHeader.flags = 0;
@@ -837,9 +854,9 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
     uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
     if (map.liquidMapOffset)
-        map.holesOffset = map.liquidMapOffset + map.liquidMapSize;
+        map.holesOffset = alignSection(map.liquidMapOffset + map.liquidMapSize);
     else
-        map.holesOffset = map.heightMapOffset + map.heightMapSize;
+        map.holesOffset = alignSection(map.heightMapOffset + map.heightMapSize);
 
     map.holesSize = sizeof(holes);
     memset(holes, 0, map.holesSize);
@@ -864,11 +881,13 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
     }
     fwrite(&map, sizeof(map), 1, output);
     // Store area data
+    writeSectionPadding(output, map.areaMapOffset);
     fwrite(&areaHeader, sizeof(areaHeader), 1, output);
     if (!(areaHeader.flags & MAP_AREA_NO_AREA))
         fwrite(area_flags, sizeof(area_flags), 1, output);
 
     // Store height data
+    writeSectionPadding(output, map.heightMapOffset);
     fwrite(&heightHeader, sizeof(heightHeader), 1, output);
     if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
     {
@@ -892,6 +911,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
+        writeSectionPadding(output, map.liquidMapOffset);
         fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
@@ -906,6 +926,7 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x, uint32
     }
 
     // store hole data
+    writeSectionPadding(output, map.holesOffset);
     fwrite(holes, map.holesSize, 1, output);
 
     fclose(output);
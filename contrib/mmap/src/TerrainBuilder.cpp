@@ -89,7 +89,7 @@ namespace MMAP
         GridMapFileHeader fheader;
         fread(&fheader, sizeof(GridMapFileHeader), 1, mapFile);
 
-        if (fheader.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)))
+        if (fheader.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)) && fheader.versionMagic != *((uint32 const*)(MAP_ALIGNED_VERSION_MAGIC)))
         {
             fclose(mapFile);
             printf("%s is the wrong version, please extract new .map files\n", mapFileName);
@@ -63,6 +63,7 @@ namespace MMAP
     // contrib/extractor/system.cpp
     // src/game/GridMap.cpp
     static char const* MAP_VERSION_MAGIC = "v1.3";
+    static char const* MAP_ALIGNED_VERSION_MAGIC = "v1.4";  // v1.3 with aligned sections, read through the offsets
 
     struct MeshData
     {
@@ -90,13 +90,26 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+        return NULL;
+
+    // get prepared statement object
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    // bind parameters
+    pStmt->bind(id);
+    // execute statement and fetch the rows
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -110,6 +123,8 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
 
+    m_infoString = infoString;
+
     // create DB connections
 
     // setup connection pool size
@@ -138,6 +153,22 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     if (!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    // additional connections for keyed async requests
+    if (nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 1; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pKeyedAsyncConns.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -154,16 +185,24 @@ void Database::StopServer()
     m_pResultQueue = NULL;
     m_pAsyncConn = NULL;
 
+    delete m_pStreamConn;
+    m_pStreamConn = NULL;
+
+    for (size_t i = 0; i < m_pKeyedAsyncConns.size(); ++i)
+        delete m_pKeyedAsyncConns[i];
+
+    m_pKeyedAsyncConns.clear();
+
     for (size_t i = 0; i < m_pQueryConnections.size(); ++i)
         delete m_pQueryConnections[i];
 
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
@@ -171,14 +210,32 @@ void Database::InitDelayThread()
     assert(!m_delayThread);
 
     // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
+    m_threadBody = CreateDelayThread(m_pAsyncConn, true);   // will deleted at m_delayThread delete
     m_delayThread = new MaNGOS::Thread(m_threadBody);
+
+    // the default thread pings all connections, the keyed ones only execute requests
+    for (size_t i = 0; i < m_pKeyedAsyncConns.size(); ++i)
+    {
+        SqlDelayThread* threadBody = CreateDelayThread(m_pKeyedAsyncConns[i], false);
+        m_keyedThreadBodies.push_back(threadBody);
+        m_keyedDelayThreads.push_back(new MaNGOS::Thread(threadBody));
+    }
 }
 
 void Database::HaltDelayThread()
 {
     if (!m_threadBody || !m_delayThread) return;
 
+    for (size_t i = 0; i < m_keyedThreadBodies.size(); ++i)
+    {
+        m_keyedThreadBodies[i]->Stop();
+        m_keyedDelayThreads[i]->wait();
+        delete m_keyedDelayThreads[i];
+    }
+
+    m_keyedThreadBodies.clear();
+    m_keyedDelayThreads.clear();
+
     m_threadBody->Stop();                                   // Stop event
     m_delayThread->wait();                                  // Wait for flush to DB
     delete m_delayThread;                                   // This also deletes m_threadBody
@@ -186,6 +243,50 @@ void Database::HaltDelayThread()
     m_threadBody = NULL;
 }
 
+SqlDelayThread* Database::getDelayThread(uint32 key)
+{
+    if (m_keyedThreadBodies.empty() || !key)
+        return m_threadBody;
+
+    size_t lane = key % (m_keyedThreadBodies.size() + 1);
+    return lane ? m_keyedThreadBodies[lane - 1] : m_threadBody;
+}
+
+uint32 Database::GetAsyncKey() const
+{
+    TransHelper* helper = m_TransStorage.get();
+    return helper ? helper->GetAsyncKey() : 0;
+}
+
+bool Database::DelayRequest(SqlOperation* op)
+{
+    TransHelper* helper = m_TransStorage.get();
+    if (!helper)
+        return m_threadBody->Delay(op);
+
+    SqlDelayThread* thread = getDelayThread(helper->GetAsyncKey());
+    SqlDelayThread* otherThread = getDelayThread(helper->GetAsyncOtherKey());
+    if (thread == otherThread)
+        return thread->Delay(op);
+
+    // rows of two owners: run on the default lane while the lanes of both keys wait at a fence.
+    // All parts must be queued before any other fence, else two lanes could wait for each other
+    int fences = int(thread != m_threadBody) + int(otherThread != m_threadBody);
+    SqlLaneFenceStatePtr state(new SqlLaneFenceState(fences));
+
+    LOCK_GUARD _guard(m_laneFenceGuard);
+    if (thread != m_threadBody)
+        thread->Delay(new SqlLaneFence(state));
+    if (otherThread != m_threadBody)
+        otherThread->Delay(new SqlLaneFence(state));
+    return m_threadBody->Delay(new SqlFencedRequest(op, state));
+}
+
+bool Database::DelayHolderRequest(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback)
+{
+    return DelayRequest(new SqlQueryHolderEx(holder, callback, m_pResultQueue));
+}
+
 void Database::ThreadStart()
 {
 }
@@ -200,6 +301,31 @@ void Database::ProcessResultQueue()
         m_pResultQueue->Update();
 }
 
+bool Database::GetDelayThreadStats(SqlDelayThread::Stats& stats) const
+{
+    if (!m_threadBody)
+        return false;
+
+    m_threadBody->GetStats(stats);
+
+    for (size_t i = 0; i < m_keyedThreadBodies.size(); ++i)
+    {
+        SqlDelayThread::Stats keyedStats;
+        m_keyedThreadBodies[i]->GetStats(keyedStats);
+
+        stats.queueSize += keyedStats.queueSize;
+        stats.queuePeak = std::max(stats.queuePeak, keyedStats.queuePeak);
+        stats.executed += keyedStats.executed;
+        stats.batches += keyedStats.batches;
+        stats.batchedRequests += keyedStats.batchedRequests;
+        stats.failedBatches += keyedStats.failedBatches;
+        for (int j = 0; j < SqlDelayThread::MAX_LATENCY_BUCKETS; ++j)
+            stats.latency[j] += keyedStats.latency[j];
+    }
+
+    return true;
+}
+
 void Database::escape_string(std::string& str)
 {
     if (str.empty())
@@ -233,11 +359,24 @@ void Database::Ping()
         delete guard->Query(sql);
     }
 
+    for (size_t i = 0; i < m_pKeyedAsyncConns.size(); ++i)
+    {
+        SqlConnection::Lock guard(m_pKeyedAsyncConns[i]);
+        delete guard->Query(sql);
+    }
+
     for (int i = 0; i < m_nQueryConnPoolSize; ++i)
     {
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    // the idle stream connection must not time out either, a busy one is in use anyway
+    {
+        boost::lock_guard<boost::mutex> guard(m_streamConnGuard);
+        if (m_pStreamConn)
+            delete m_pStreamConn->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -303,6 +442,62 @@ QueryResult* Database::PQuery(const char* format, ...)
     return Query(szQuery);
 }
 
+QueryResult* Database::PQueryStream(const char* format, ...)
+{
+    if (!format) return NULL;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return NULL;
+    }
+
+    return QueryStream(szQuery);
+}
+
+SqlConnection* Database::AcquireStreamConnection()
+{
+    {
+        boost::lock_guard<boost::mutex> guard(m_streamConnGuard);
+        if (m_pStreamConn)
+        {
+            SqlConnection* conn = m_pStreamConn;
+            m_pStreamConn = NULL;
+            return conn;
+        }
+    }
+
+    // first stream or another stream is still being read
+    SqlConnection* conn = CreateConnection();
+    if (!conn->Initialize(m_infoString.c_str()))
+    {
+        delete conn;
+        return NULL;
+    }
+
+    return conn;
+}
+
+void Database::ReleaseStreamConnection(SqlConnection* conn)
+{
+    {
+        boost::lock_guard<boost::mutex> guard(m_streamConnGuard);
+        if (!m_pStreamConn)
+        {
+            m_pStreamConn = conn;
+            return;
+        }
+    }
+
+    delete conn;
+}
+
 QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 {
     if (!format) return NULL;
@@ -343,7 +538,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayRequest(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -417,7 +612,7 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_TransStorage->detach());
+    DelayRequest(m_TransStorage->detach());
     return true;
 }
 
@@ -561,7 +756,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayRequest(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -576,6 +771,15 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::auto_ptr<SqlStmtParameters> p(params);
+    // execute statement on one of the connections for sync requests
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
@@ -622,6 +826,31 @@ std::string Database::GetStmtString(const int stmtId) const
 }
 
 // HELPER CLASSES AND FUNCTIONS
+Database::AsyncKeyGuard::AsyncKeyGuard(Database& db, uint32 key) : m_db(db)
+{
+    Init(key, key);
+}
+
+Database::AsyncKeyGuard::AsyncKeyGuard(Database& db, uint32 key, uint32 otherKey) : m_db(db)
+{
+    Init(key, otherKey);
+}
+
+void Database::AsyncKeyGuard::Init(uint32 key, uint32 otherKey)
+{
+    if (!m_db.m_TransStorage.get())
+        m_db.m_TransStorage.reset(new TransHelper());
+
+    m_prevKey = m_db.m_TransStorage->GetAsyncKey();
+    m_prevOtherKey = m_db.m_TransStorage->GetAsyncOtherKey();
+    m_db.m_TransStorage->SetAsyncKeys(key, otherKey);
+}
+
+Database::AsyncKeyGuard::~AsyncKeyGuard()
+{
+    m_db.m_TransStorage->SetAsyncKeys(m_prevKey, m_prevOtherKey);
+}
+
 Database::TransHelper::~TransHelper()
 {
     reset();
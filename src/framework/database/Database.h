@@ -36,8 +36,14 @@ class SqlResultQueue;
 class SqlQueryHolder;
 class SqlStmtParameters;
 class SqlParamBinder;
+class SqlOperation;
 class Database;
 
+namespace MaNGOS
+{
+    class IQueryCallback;
+}
+
 #define MAX_QUERY_LEN   (32*1024)
 
 //
@@ -66,6 +72,7 @@ class MANGOS_DLL_SPEC SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         // SqlConnection object lock
         class Lock
@@ -108,12 +115,42 @@ class MANGOS_DLL_SPEC Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        // nAsyncConns > 1 adds connections for async requests issued under an AsyncKeyGuard
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
+        // Async requests (Execute, statements, transactions, async queries) issued by the current thread
+        // while the guard lives are executed on the connection selected by key. Requests with the same key
+        // keep their order, requests without key are all executed in order on the default connection.
+        // The key names the owner of the rows the requests touch, e.g. the account for its characters or
+        // the guild for its members, so it is set where the requests are built.
+        // otherKey is for requests touching rows of two owners, e.g. items changing hands, 0 also naming the
+        // default connection. They run on the default connection while the connections of both keys wait,
+        // in order with the requests of both.
+        class MANGOS_DLL_SPEC AsyncKeyGuard
+        {
+            public:
+                AsyncKeyGuard(Database& db, uint32 key);
+                AsyncKeyGuard(Database& db, uint32 key, uint32 otherKey);
+                ~AsyncKeyGuard();
+
+            private:
+                AsyncKeyGuard(const AsyncKeyGuard&);
+                AsyncKeyGuard& operator=(const AsyncKeyGuard&);
+
+                void Init(uint32 key, uint32 otherKey);
+
+                Database& m_db;
+                uint32 m_prevKey;
+                uint32 m_prevOtherKey;
+        };
+
+        // key of the AsyncKeyGuard of the current thread, 0 if none
+        uint32 GetAsyncKey() const;
+
         /// Synchronous DB queries
         inline QueryResult* Query(const char* sql)
         {
@@ -130,6 +167,17 @@ class MANGOS_DLL_SPEC Database
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        // unbuffered query for bulk loading, rows are read from the server while iterating instead of
+        // being stored in client memory first. GetRowCount() of such a result only counts the rows fetched so far.
+        // The rows come over a connection of their own, never one of the query pool, and that connection does
+        // nothing else until the result is deleted. Other queries made while iterating go to the pool as usual.
+        // The server keeps the read open that long too (a MyISAM table stays read locked), so delete the result
+        // as soon as the rows are read and don't write to the streamed table while iterating.
+        virtual QueryResult* QueryStream(const char* sql) { return Query(sql); }
+        QueryResult* PQueryStream(const char* format, ...) ATTR_PRINTF(2, 3);
+        // called by a finished streamed result, keeps the connection for the next QueryStream()
+        void ReleaseStreamConnection(SqlConnection* conn);
+
         inline bool DirectExecute(const char* sql)
         {
             if (!m_pAsyncConn)
@@ -219,6 +267,10 @@ class MANGOS_DLL_SPEC Database
         // function to ping database connections
         void Ping();
 
+        // queue and latency statistics summed over the async request threads, false if they are not running
+        bool GetDelayThreadStats(SqlDelayThread::Stats& stats) const;
+        size_t GetAsyncConnectionCount() const { return m_pKeyedAsyncConns.size() + 1; }
+
         // set this to allow async transactions
         // you should call it explicitly after your server successfully started up
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
@@ -226,7 +278,7 @@ class MANGOS_DLL_SPEC Database
 
     protected:
         Database() :
-            m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
+            m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pStreamConn(NULL), m_pResultQueue(NULL),
             m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
@@ -238,12 +290,12 @@ class MANGOS_DLL_SPEC Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         class MANGOS_DLL_SPEC TransHelper
         {
             public:
-                TransHelper() : m_pTrans(NULL) {}
+                TransHelper() : m_pTrans(NULL), m_asyncKey(0), m_asyncOtherKey(0) {}
                 ~TransHelper();
 
                 // initializes new SqlTransaction object
@@ -257,8 +309,15 @@ class MANGOS_DLL_SPEC Database
                 // destroyes SqlTransaction allocated by init() function
                 void reset();
 
+                // keys set by AsyncKeyGuard, the same for a single key, 0 if none
+                uint32 GetAsyncKey() const { return m_asyncKey; }
+                uint32 GetAsyncOtherKey() const { return m_asyncOtherKey; }
+                void SetAsyncKeys(uint32 key, uint32 otherKey) { m_asyncKey = key; m_asyncOtherKey = otherKey; }
+
             private:
                 SqlTransaction* m_pTrans;
+                uint32 m_asyncKey;
+                uint32 m_asyncOtherKey;
         };
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
@@ -270,12 +329,20 @@ class MANGOS_DLL_SPEC Database
         SqlConnection* getQueryConnection();
         // for now return one single connection for async requests
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // delay thread serving the async key
+        SqlDelayThread* getDelayThread(uint32 key);
+        // queue an async request in the lane of the keys of the current thread, see AsyncKeyGuard
+        bool DelayRequest(SqlOperation* op);
+        bool DelayHolderRequest(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback);
+        // connection for QueryStream(), a new one is opened if the kept one is in use. NULL on connect error
+        SqlConnection* AcquireStreamConnection();
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
         // query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                           // current size of query connection pool
@@ -285,13 +352,26 @@ class MANGOS_DLL_SPEC Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        std::string m_infoString;                           // connection string, for connections opened after Initialize()
+
+        // default DB connection for transactions and async requests without key
         SqlConnection* m_pAsyncConn;
 
+        // idle connection for unbuffered queries, owned by the streamed result while it is read
+        SqlConnection* m_pStreamConn;
+        boost::mutex m_streamConnGuard;
+
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread* m_delayThread;                      ///< Pointer to executer thread
 
+        // additional async connections with their own delay threads, used for keyed requests
+        SqlConnectionContainer m_pKeyedAsyncConns;
+        std::vector<SqlDelayThread*> m_keyedThreadBodies;
+        std::vector<MaNGOS::Thread*> m_keyedDelayThreads;
+
+        boost::mutex m_laneFenceGuard;                      // keeps fences in the same order in all lanes
+
         bool m_bAllowAsyncTransactions;                     ///< flag which specifies if async transactions are enabled
 
         // PREPARED STATEMENT REGISTRY
@@ -68,6 +68,17 @@ SqlConnection* DatabaseMysql::CreateConnection()
     return new MySQLConnection(*this);
 }
 
+QueryResult* DatabaseMysql::QueryStream(const char* sql)
+{
+    // never a pooled connection: the server keeps the statement open until the last row is read, so the
+    // connection is busy for the whole iteration and other users of the pool would wait for the loader
+    SqlConnection* conn = AcquireStreamConnection();
+    if (!conn)
+        return Query(sql);                                  // no extra connection available, load buffered
+
+    return static_cast<MySQLConnection*>(conn)->QueryStream(sql);
+}
+
 MySQLConnection::~MySQLConnection()
 {
     FreePreparedStatements();
@@ -179,6 +190,8 @@ bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD**
     if (!mMysql)
         return 0;
 
+    MANGOS_ASSERT(!mStreaming);
+
     uint32 _s = WorldTimer::getMSTime();
 
     if (mysql_query(mMysql, sql))
@@ -245,11 +258,52 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+QueryResult* MySQLConnection::QueryStream(const char* sql)
+{
+    MANGOS_ASSERT(!mStreaming);
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_RES* result = NULL;
+    if (mysql_query(mMysql, sql))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+    }
+    else
+    {
+        DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+        // rows stay on the server until fetched one by one
+        result = mysql_use_result(mMysql);
+    }
+
+    if (!result)
+    {
+        m_db.ReleaseStreamConnection(this);
+        return NULL;
+    }
+
+    mStreaming = true;
+    QueryResultMysql* queryResult = new QueryResultMysql(result, mysql_fetch_fields(result), 0, mysql_field_count(mMysql), this);
+
+    // empty result, the connection was already given back by NextRow()
+    if (!queryResult->NextRow())
+    {
+        delete queryResult;
+        return NULL;
+    }
+
+    return queryResult;
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!mMysql)
         return false;
 
+    MANGOS_ASSERT(!mStreaming);
+
     {
         uint32 _s = WorldTimer::getMSTime();
 
@@ -453,6 +507,7 @@ void MySqlPreparedStatement::RemoveBinds()
     m_pResultMetadata = NULL;
     m_pResult = NULL;
     m_pInputArgs = NULL;
+    m_resultColumns.clear();
 
     m_bPrepared = false;
 }
@@ -472,6 +527,163 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+void MySqlPreparedStatement::BindResults()
+{
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+
+    m_pResult = new MYSQL_BIND[m_nColumns];
+    memset(m_pResult, 0, sizeof(MYSQL_BIND) * m_nColumns);
+    m_resultColumns.resize(m_nColumns);
+
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        ResultColumn& column = m_resultColumns[i];
+        MYSQL_BIND& bind = m_pResult[i];
+
+        bind.length = &column.length;
+        bind.is_null = &column.isNull;
+        bind.error = &column.error;
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &column.number;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) ? 1 : 0;
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &column.number;
+                break;
+            default:
+                // strings, blobs, decimals and dates are fetched as text, like with plain queries
+                column.text.resize(std::min<unsigned long>(fields[i].length, 255) + 1);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &column.text[0];
+                bind.buffer_length = column.text.size();
+                break;
+        }
+    }
+}
+
+bool MySqlPreparedStatement::FetchTruncatedColumns()
+{
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        ResultColumn& column = m_resultColumns[i];
+        MYSQL_BIND& bind = m_pResult[i];
+
+        if (!column.error || bind.buffer_type != MYSQL_TYPE_STRING)
+            continue;
+
+        column.text.resize(column.length + 1);
+        bind.buffer = &column.text[0];
+        bind.buffer_length = column.text.size();
+
+        if (mysql_stmt_fetch_column(m_stmt, &bind, i, 0))
+        {
+            sLog.outError("SQL: cannot fetch column %u of '%s'", i, m_szFmt.c_str());
+            sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+            return false;
+        }
+    }
+
+    // the grown buffers are used from the next row on
+    if (mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return false;
+    }
+
+    return true;
+}
+
+QueryResult* MySqlPreparedStatement::query()
+{
+    if (!isPrepared() || !isQuery())
+        return NULL;
+
+    if (!m_pResult)
+        BindResults();
+
+    if (mysql_stmt_execute(m_stmt))
+    {
+        sLog.outError("SQL: cannot execute '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    QueryResultMysqlStmt* result = new QueryResultMysqlStmt(mysql_fetch_fields(m_pResultMetadata), m_nColumns);
+
+    for (;;)
+    {
+        int fetchResult = mysql_stmt_fetch(m_stmt);
+        if (fetchResult == MYSQL_NO_DATA)
+            break;
+
+        if (fetchResult == 1 || (fetchResult == MYSQL_DATA_TRUNCATED && !FetchTruncatedColumns()))
+        {
+            if (fetchResult == 1)
+            {
+                sLog.outError("SQL: cannot fetch result of '%s'", m_szFmt.c_str());
+                sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+            }
+
+            delete result;
+            mysql_stmt_free_result(m_stmt);
+            return NULL;
+        }
+
+        for (uint32 i = 0; i < m_nColumns; ++i)
+        {
+            const ResultColumn& column = m_resultColumns[i];
+            const MYSQL_BIND& bind = m_pResult[i];
+
+            if (column.isNull)
+                result->AddNull();
+            else if (bind.buffer_type == MYSQL_TYPE_LONGLONG)
+            {
+                if (bind.is_unsigned)
+                    result->AddUInt(column.number.u);
+                else
+                    result->AddInt(column.number.i);
+            }
+            else if (bind.buffer_type == MYSQL_TYPE_DOUBLE)
+                result->AddDouble(column.number.d);
+            else
+                result->AddText(&column.text[0], column.length);
+        }
+
+        result->FinishRow();
+    }
+
+    mysql_stmt_free_result(m_stmt);
+
+    // same as plain queries: no rows, no result
+    if (!result->GetRowCount())
+    {
+        delete result;
+        return NULL;
+    }
+
+    result->NextRow();
+    return result;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, my_bool& bUnsigned)
 {
     bUnsigned = 0;
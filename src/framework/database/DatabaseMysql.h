@@ -49,6 +49,9 @@ class MANGOS_DLL_SPEC MySqlPreparedStatement : public SqlPreparedStatement
         // execute DML statement
         virtual bool execute() override;
 
+        // execute SELECT statement, the rows are fetched in binary form
+        virtual QueryResult* query() override;
+
     protected:
         // bind parameters
         void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
@@ -57,18 +60,38 @@ class MANGOS_DLL_SPEC MySqlPreparedStatement : public SqlPreparedStatement
 
     private:
         void RemoveBinds();
+        // bind output buffers for the result columns
+        void BindResults();
+        // grow the buffers of text columns that did not fit and fetch them again
+        bool FetchTruncatedColumns();
+
+        // output buffer of one result column
+        struct ResultColumn
+        {
+            union
+            {
+                int64 i;
+                uint64 u;
+                double d;
+            } number;
+            std::vector<char> text;
+            unsigned long length;
+            my_bool isNull;
+            my_bool error;
+        };
 
         MYSQL* m_pMySQLConn;
         MYSQL_STMT* m_stmt;
         MYSQL_BIND* m_pInputArgs;
         MYSQL_BIND* m_pResult;
         MYSQL_RES* m_pResultMetadata;
+        std::vector<ResultColumn> m_resultColumns;
 };
 
 class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
 {
     public:
-        MySQLConnection(Database& db) : SqlConnection(db), mMysql(NULL) {}
+        MySQLConnection(Database& db) : SqlConnection(db), mMysql(NULL), mStreaming(false) {}
         ~MySQLConnection();
 
         //! Initializes Mysql and connects to a server.
@@ -89,10 +112,18 @@ class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
         SqlPreparedStatement* CreateStatement(const std::string& fmt) override;
 
     private:
+        friend class DatabaseMysql;
+        friend class QueryResultMysql;
+
+        // unbuffered query, only for connections from Database::AcquireStreamConnection() that no one else uses.
+        // The returned result owns the connection until it ends, any other query on it before that asserts.
+        QueryResult* QueryStream(const char* sql);
+
         bool _TransactionCmd(const char* sql);
         bool _Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount);
 
         MYSQL* mMysql;
+        bool mStreaming;                                    // a streamed result is still reading from this connection
 };
 
 class MANGOS_DLL_SPEC DatabaseMysql : public Database
@@ -108,6 +139,8 @@ class MANGOS_DLL_SPEC DatabaseMysql : public Database
         // must be call before finish thread run
         void ThreadEnd() override;
 
+        QueryResult* QueryStream(const char* sql) override;
+
     protected:
         virtual SqlConnection* CreateConnection() override;
 
@@ -16,5 +16,66 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
 
+void Field::SetParsedValue(const char* value)
+{
+    mValue = value;
+    mStorage = STORAGE_TEXT;
+
+    if (!value)
+        return;
+
+    switch (mType)
+    {
+        case DB_TYPE_INTEGER:
+        {
+            int64 number;
+            if (!ParseInteger(value, number))
+                return;                                     // not a plain number (enum names, dates), keep the text
+
+            if (number < 0)
+            {
+                mNumber.i = number;
+                mStorage = STORAGE_INT;
+            }
+            else
+            {
+                mNumber.u = uint64(number);
+                mStorage = STORAGE_UINT;
+            }
+            break;
+        }
+        case DB_TYPE_FLOAT:
+            mNumber.d = atof(value);
+            mStorage = STORAGE_FLOAT;
+            break;
+        default:
+            break;
+    }
+}
+
+// decimal integer with optional sign and nothing else, unsigned values above INT64_MAX wrap
+// which is what GetUInt64() returns for them anyway
+bool Field::ParseInteger(const char* value, int64& result)
+{
+    bool negative = false;
+    if (*value == '-')
+    {
+        negative = true;
+        ++value;
+    }
+
+    if (*value < '0' || *value > '9')
+        return false;
+
+    uint64 number = 0;
+    for (; *value >= '0' && *value <= '9'; ++value)
+        number = number * 10 + uint64(*value - '0');
+
+    if (*value != '\0')
+        return false;
+
+    result = negative ? -int64(number) : int64(number);
+    return true;
+}
@@ -34,28 +34,57 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        // how the value is held, text values are parsed by the getters,
+        // numeric values come from binary result sets and are returned without parsing
+        enum StorageTypes
+        {
+            STORAGE_TEXT    = 0,
+            STORAGE_INT     = 1,
+            STORAGE_UINT    = 2,
+            STORAGE_FLOAT   = 3
+        };
+
+        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN), mStorage(STORAGE_TEXT) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mStorage(STORAGE_TEXT) {}
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return mStorage == STORAGE_TEXT && mValue == NULL; }
 
-        const char* GetString() const { return mValue; }
+        const char* GetString() const
+        {
+            if (mStorage != STORAGE_TEXT && !mValue)
+                FormatNumber();
+            return mValue;
+        }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
+        }
+        float GetFloat() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return GetNumber<float>();
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const
+        {
+            if (mStorage != STORAGE_TEXT)
+                return GetNumber<int64>() > 0;
+            return mValue ? atoi(mValue) > 0 : false;
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        int32 GetInt32() const { return mStorage != STORAGE_TEXT ? GetNumber<int32>() : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        uint8 GetUInt8() const { return mStorage != STORAGE_TEXT ? GetNumber<uint8>() : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint16 GetUInt16() const { return mStorage != STORAGE_TEXT ? GetNumber<uint16>() : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        int16 GetInt16() const { return mStorage != STORAGE_TEXT ? GetNumber<int16>() : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        uint32 GetUInt32() const { return mStorage != STORAGE_TEXT ? GetNumber<uint32>() : mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mStorage != STORAGE_TEXT)
+                return GetNumber<uint64>();
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -66,13 +95,64 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { mValue = value; mStorage = STORAGE_TEXT; }
+        // same as SetValue() but integer and float columns are decoded once here, the getters
+        // then return the stored number instead of parsing the text on every call
+        void SetParsedValue(const char* value);
+
+        // binary values, the text form is only built if GetString() is called
+        void SetInt64(int64 value) { mNumber.i = value; mValue = NULL; mStorage = STORAGE_INT; }
+        void SetUInt64(uint64 value) { mNumber.u = value; mValue = NULL; mStorage = STORAGE_UINT; }
+        void SetDouble(double value) { mNumber.d = value; mValue = NULL; mStorage = STORAGE_FLOAT; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
-        const char* mValue;
+        template<typename T>
+        T GetNumber() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT:   return static_cast<T>(mNumber.i);
+                case STORAGE_UINT:  return static_cast<T>(mNumber.u);
+                case STORAGE_FLOAT: return FromDouble<T>(mNumber.d);
+                default:            return T(0);
+            }
+        }
+
+        // truncate like atol() did for the text form, negative values wrap for unsigned types
+        template<typename T>
+        static T FromDouble(double value) { return static_cast<T>(static_cast<int64>(value)); }
+
+        static bool ParseInteger(const char* value, int64& result);
+
+        void FormatNumber() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT:   snprintf(mText, sizeof(mText), SI64FMTD, mNumber.i); break;
+                case STORAGE_UINT:  snprintf(mText, sizeof(mText), UI64FMTD, mNumber.u); break;
+                case STORAGE_FLOAT: snprintf(mText, sizeof(mText), "%.17g", mNumber.d); break;
+                default:            mText[0] = '\0'; break;
+            }
+            mValue = mText;
+        }
+
+        mutable const char* mValue;
         enum DataTypes mType;
+        enum StorageTypes mStorage;
+
+        union
+        {
+            int64 i;
+            uint64 u;
+            double d;
+        } mNumber;
+
+        mutable char mText[32];                             // text form of a binary value, see FormatNumber()
 };
+
+template<> inline float Field::FromDouble<float>(double value) { return static_cast<float>(value); }
+template<> inline double Field::FromDouble<double>(double value) { return value; }
 #endif
@@ -21,8 +21,8 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 
-QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
-    QueryResult(rowCount, fieldCount), mResult(result)
+QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConn) :
+    QueryResult(rowCount, fieldCount), mResult(result), mStreamConn(streamConn)
 {
     mCurrentRow = new Field[mFieldCount];
     MANGOS_ASSERT(mCurrentRow);
@@ -46,12 +46,19 @@ bool QueryResultMysql::NextRow()
     row = mysql_fetch_row(mResult);
     if (!row)
     {
+        // for a streamed result this can also be a connection error in the middle of the rows
+        if (mStreamConn && mysql_errno(mResult->handle))
+            sLog.outErrorDb("query ERROR while reading rows: %s", mysql_error(mResult->handle));
+
         EndQuery();
         return false;
     }
 
+    if (mStreamConn)
+        ++mRowCount;
+
     for (uint32 i = 0; i < mFieldCount; ++i)
-        mCurrentRow[i].SetValue(row[i]);
+        mCurrentRow[i].SetParsedValue(row[i]);
 
     return true;
 }
@@ -63,12 +70,20 @@ void QueryResultMysql::EndQuery()
 
     if (mResult)
     {
+        // for a streamed result this also reads and drops the rows not fetched yet
         mysql_free_result(mResult);
         mResult = 0;
     }
+
+    if (mStreamConn)
+    {
+        mStreamConn->mStreaming = false;
+        mStreamConn->DB().ReleaseStreamConnection(mStreamConn);
+        mStreamConn = NULL;
+    }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -98,4 +113,85 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_FIELD* fields, uint32 fieldCount) :
+    QueryResult(0, fieldCount), mNextRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    delete[] mCurrentRow;
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (mNextRow >= mRowCount)
+        return false;
+
+    const Cell* row = &mCells[mNextRow * mFieldCount];
+    ++mNextRow;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        const Cell& cell = row[i];
+        switch (cell.type)
+        {
+            case CELL_INT:   mCurrentRow[i].SetInt64(cell.value.i); break;
+            case CELL_UINT:  mCurrentRow[i].SetUInt64(cell.value.u); break;
+            case CELL_FLOAT: mCurrentRow[i].SetDouble(cell.value.d); break;
+            case CELL_TEXT:  mCurrentRow[i].SetValue(&mText[cell.value.offset]); break;
+            default:         mCurrentRow[i].SetValue(NULL); break;
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlStmt::AddNull()
+{
+    Cell cell;
+    cell.type = CELL_NULL;
+    cell.value.u = 0;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddInt(int64 value)
+{
+    Cell cell;
+    cell.type = CELL_INT;
+    cell.value.i = value;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddUInt(uint64 value)
+{
+    Cell cell;
+    cell.type = CELL_UINT;
+    cell.value.u = value;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddDouble(double value)
+{
+    Cell cell;
+    cell.type = CELL_FLOAT;
+    cell.value.d = value;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddText(const char* value, size_t length)
+{
+    Cell cell;
+    cell.type = CELL_TEXT;
+    cell.value.offset = mText.size();
+    mCells.push_back(cell);
+
+    mText.insert(mText.end(), value, value + length);
+    mText.push_back('\0');
+}
 #endif
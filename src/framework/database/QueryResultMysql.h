@@ -23,6 +23,8 @@
 
 #include "Common.h"
 
+class MySQLConnection;
+
 #ifdef WIN32
 #include <winsock2.h>
 #include <mysql/mysql.h>
@@ -33,17 +35,67 @@
 class QueryResultMysql : public QueryResult
 {
     public:
-        QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // streamConn is set for mysql_use_result() results: rows are counted while fetched
+        // and the connection is given back to its Database when the result ends
+        QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount, MySQLConnection* streamConn = NULL);
 
         ~QueryResultMysql();
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
+        MySQLConnection* mStreamConn;
+};
+
+// Result of a prepared statement query. MySqlPreparedStatement fetches all rows in binary form
+// into this object, numeric columns are handed to Field without a text round trip.
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(MYSQL_FIELD* fields, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow() override;
+
+        // filling, one call per column in column order, then FinishRow()
+        void AddNull();
+        void AddInt(int64 value);
+        void AddUInt(uint64 value);
+        void AddDouble(double value);
+        void AddText(const char* value, size_t length);
+        void FinishRow() { ++mRowCount; }
+
+    private:
+        enum CellTypes
+        {
+            CELL_NULL,
+            CELL_INT,
+            CELL_UINT,
+            CELL_FLOAT,
+            CELL_TEXT
+        };
+
+        struct Cell
+        {
+            uint8 type;
+            union
+            {
+                int64 i;
+                uint64 u;
+                double d;
+                size_t offset;                              // into mText
+            } value;
+        };
+
+        std::vector<Cell> mCells;
+        std::vector<char> mText;
+        uint64 mNextRow;
 };
 #endif
 #endif
@@ -54,7 +54,7 @@ bool QueryResultPostgre::NextRow()
         if (pPQgetvalue && !(*pPQgetvalue))
             pPQgetvalue = NULL;
 
-        mCurrentRow[j].SetValue(pPQgetvalue);
+        mCurrentRow[j].SetParsedValue(pPQgetvalue);
     }
     ++mTableIndex;
 
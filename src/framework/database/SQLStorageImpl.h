@@ -189,7 +189,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         delete result;
     }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    // row count is known from above, so the rows can be streamed instead of buffered client side
+    result = WorldDatabase.PQueryStream("SELECT * FROM %s", store.GetTableName());
 
     if (!result)
     {
@@ -19,9 +19,16 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Timer.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <boost/thread/lock_guard.hpp>
+
+const uint32 SqlDelayThread::LatencyBucketLimits[MAX_LATENCY_BUCKETS - 1] = { 1, 5, 10, 50, 100, 500 };
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_dbEngine(db), m_dbConnection(conn),
+    m_running(true), m_pingDatabase(pingDatabase)
 {
+    memset(&m_stats, 0, sizeof(m_stats));
 }
 
 SqlDelayThread::~SqlDelayThread()
@@ -30,28 +37,66 @@ SqlDelayThread::~SqlDelayThread()
     ProcessRequests();
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql)
+{
+    {
+        boost::lock_guard<boost::mutex> guard(m_queueLock);
+
+        m_sqlQueue.push_back(QueuedOperation(sql, WorldTimer::getMSTime()));
+        if (m_sqlQueue.size() > m_stats.queuePeak)
+            m_stats.queuePeak = m_sqlQueue.size();
+    }
+
+    m_queueCondition.notify_one();
+    return true;
+}
+
 void SqlDelayThread::run()
 {
 #ifndef DO_POSTGRESQL
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
+    // 0 disables the keep alive ping
+    const uint32 pingInterval = m_pingDatabase ? m_dbEngine->GetPingIntervall() : 0;
+    uint32 lastPing = WorldTimer::getMSTime();
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
-
-    uint32 loopCounter = 0;
-    while (m_running)
+    for (;;)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        bool running;
+
+        {
+            boost::unique_lock<boost::mutex> guard(m_queueLock);
+
+            // sleep until there is work, the connection needs a ping or the thread is stopped
+            while (m_running && m_sqlQueue.empty())
+            {
+                if (!pingInterval)
+                {
+                    m_queueCondition.wait(guard);
+                    continue;
+                }
+
+                uint32 sinceLastPing = WorldTimer::getMSTimeDiff(lastPing, WorldTimer::getMSTime());
+                if (sinceLastPing >= pingInterval)
+                    break;
+
+                m_queueCondition.timed_wait(guard, boost::posix_time::milliseconds(pingInterval - sinceLastPing));
+            }
+
+            running = m_running;
+        }
 
+        // if the running state gets turned off while waiting
+        // empty the queue before exiting
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (!running)
+            break;
+
+        if (pingInterval && WorldTimer::getMSTimeDiff(lastPing, WorldTimer::getMSTime()) >= pingInterval)
         {
-            loopCounter = 0;
+            lastPing = WorldTimer::getMSTime();
             m_dbEngine->Ping();
         }
     }
@@ -63,15 +108,136 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        boost::lock_guard<boost::mutex> guard(m_queueLock);
+        m_running = false;
+    }
+
+    m_queueCondition.notify_one();
+}
+
+void SqlDelayThread::GetStats(Stats& stats) const
+{
+    boost::lock_guard<boost::mutex> guard(m_queueLock);
+
+    stats = m_stats;
+    stats.queueSize = m_sqlQueue.size();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    SqlOperation* s = NULL;
-    while (m_sqlQueue.next(s))
+    // take everything queued so far at once, producers are not blocked while the requests run
+    SqlQueue requests;
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        boost::lock_guard<boost::mutex> guard(m_queueLock);
+        requests.swap(m_sqlQueue);
     }
+
+    if (requests.empty())
+        return;
+
+    Stats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    SqlQueue::iterator itr = requests.begin();
+    while (itr != requests.end())
+    {
+        SqlQueue::iterator next = itr;
+        ++next;
+
+#ifndef DO_POSTGRESQL
+        // consecutive writes are committed together, see ExecuteBatch for failing writes
+        if (itr->m_op->IsBatchable() && next != requests.end() && next->m_op->IsBatchable())
+        {
+            itr = ExecuteBatch(itr, requests.end(), stats);
+            continue;
+        }
+#endif
+
+        itr->m_op->Execute(m_dbConnection);
+        delete itr->m_op;
+
+        AddLatency(stats, itr->m_queuedTime, WorldTimer::getMSTime());
+        itr = next;
+    }
+
+    boost::lock_guard<boost::mutex> guard(m_queueLock);
+
+    m_stats.executed += stats.executed;
+    m_stats.batches += stats.batches;
+    m_stats.batchedRequests += stats.batchedRequests;
+    m_stats.failedBatches += stats.failedBatches;
+    for (int i = 0; i < MAX_LATENCY_BUCKETS; ++i)
+        m_stats.latency[i] += stats.latency[i];
+}
+
+SqlDelayThread::SqlQueue::iterator SqlDelayThread::ExecuteBatch(SqlQueue::iterator itr, SqlQueue::iterator end, Stats& stats)
+{
+    SqlConnection::Lock guard(m_dbConnection);
+
+    if (!m_dbConnection->BeginTransaction())
+    {
+        // execute just this one on its own, the next call will try again
+        itr->m_op->Execute(m_dbConnection);
+        delete itr->m_op;
+
+        AddLatency(stats, itr->m_queuedTime, WorldTimer::getMSTime());
+        return ++itr;
+    }
+
+    SqlQueue::iterator first = itr;
+    uint32 count = 0;
+    bool failed = false;
+
+    for (; itr != end && itr->m_op->IsBatchable() && count < MAX_BATCH_SIZE; ++itr, ++count)
+    {
+        if (!itr->m_op->Execute(m_dbConnection))
+        {
+            failed = true;
+            ++itr;                                          // the failing write is replayed too
+            break;
+        }
+    }
+
+    if (!failed && !m_dbConnection->CommitTransaction())
+        failed = true;
+
+    if (failed)
+    {
+        // A deadlock, or a lock wait timeout with innodb_rollback_on_timeout, rolls back the whole
+        // transaction and not only the failing statement. Roll back in any case and replay the
+        // executed writes one by one, so each of them ends up as if it was executed alone.
+        m_dbConnection->RollbackTransaction();
+
+        for (SqlQueue::iterator replay = first; replay != itr; ++replay)
+            replay->m_op->Execute(m_dbConnection);
+
+        ++stats.failedBatches;
+    }
+    else
+    {
+        ++stats.batches;
+        stats.batchedRequests += count;
+    }
+
+    uint32 now = WorldTimer::getMSTime();
+    for (; first != itr; ++first)
+    {
+        delete first->m_op;
+        AddLatency(stats, first->m_queuedTime, now);
+    }
+
+    return itr;
+}
+
+void SqlDelayThread::AddLatency(Stats& stats, uint32 queuedTime, uint32 now)
+{
+    uint32 latency = WorldTimer::getMSTimeDiff(queuedTime, now);
+
+    int bucket = 0;
+    while (bucket < MAX_LATENCY_BUCKETS - 1 && latency >= LatencyBucketLimits[bucket])
+        ++bucket;
+
+    ++stats.executed;
+    ++stats.latency[bucket];
 }
@@ -19,8 +19,11 @@
 #ifndef __SQLDELAYTHREAD_H
 #define __SQLDELAYTHREAD_H
 
+#include "Common.h"
+
 #include <boost/thread/mutex.hpp>
-#include "LockedQueue.h"
+#include <boost/thread/condition_variable.hpp>
+#include <deque>
 #include "Threading.h"
 
 class Database;
@@ -29,25 +32,62 @@ class SqlConnection;
 
 class SqlDelayThread : public MaNGOS::Runnable
 {
-    typedef MaNGOS::LockedQueue<SqlOperation*, boost::mutex> SqlQueue;
+    public:
+        enum
+        {
+            MAX_LATENCY_BUCKETS = 7,                        ///< <1, <5, <10, <50, <100, <500 and >=500 ms
+            MAX_BATCH_SIZE      = 128                       ///< max writes grouped into one transaction
+        };
 
-    private:
-        SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
-        Database* m_dbEngine;                               ///< Pointer to used Database engine
-        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
-        volatile bool m_running;
+        struct Stats
+        {
+            size_t queueSize;                               ///< requests waiting right now
+            size_t queuePeak;                               ///< highest queue size seen
+            uint64 executed;                                ///< requests executed in total
+            uint64 batches;                                 ///< transactions started for grouped writes
+            uint64 batchedRequests;                         ///< writes executed inside such transactions
+            uint64 failedBatches;                           ///< transactions rolled back and replayed write by write
+            uint64 latency[MAX_LATENCY_BUCKETS];            ///< time from Delay() until execution
+        };
 
-        // process all enqueued requests
-        void ProcessRequests();
+        static const uint32 LatencyBucketLimits[MAX_LATENCY_BUCKETS - 1];
 
-    public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql);
 
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
+
+        void GetStats(Stats& stats) const;
+
+    private:
+        struct QueuedOperation
+        {
+            QueuedOperation(SqlOperation* op, uint32 time) : m_op(op), m_queuedTime(time) {}
+
+            SqlOperation* m_op;
+            uint32 m_queuedTime;
+        };
+
+        typedef std::deque<QueuedOperation> SqlQueue;
+
+        SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
+        mutable boost::mutex m_queueLock;                   ///< Protects m_sqlQueue, m_running and the stats
+        boost::condition_variable m_queueCondition;         ///< Signalled by Delay() and Stop()
+        Database* m_dbEngine;                               ///< Pointer to used Database engine
+        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
+        bool m_running;
+        bool m_pingDatabase;                                ///< Keep the connections of m_dbEngine alive
+
+        Stats m_stats;
+
+        // process all enqueued requests
+        void ProcessRequests();
+        // execute writes starting at itr in one transaction, returns the first request not executed
+        SqlQueue::iterator ExecuteBatch(SqlQueue::iterator itr, SqlQueue::iterator end, Stats& stats);
+        static void AddLatency(Stats& stats, uint32 queuedTime, uint32 now);
 };
 #endif                                                      //__SQLDELAYTHREAD_H
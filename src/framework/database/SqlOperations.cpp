@@ -21,6 +21,8 @@
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
 
+#include <boost/thread/lock_guard.hpp>
+
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
@@ -80,6 +82,37 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+/// ---- LANE FENCES ----
+
+bool SqlLaneFence::Execute(SqlConnection* /*conn*/)
+{
+    boost::unique_lock<boost::mutex> guard(m_state->lock);
+
+    --m_state->pendingFences;
+    m_state->condition.notify_all();
+
+    while (!m_state->done)
+        m_state->condition.wait(guard);
+
+    return true;
+}
+
+bool SqlFencedRequest::Execute(SqlConnection* conn)
+{
+    {
+        boost::unique_lock<boost::mutex> guard(m_state->lock);
+        while (m_state->pendingFences > 0)
+            m_state->condition.wait(guard);
+    }
+
+    bool res = m_op->Execute(conn);
+
+    boost::lock_guard<boost::mutex> guard(m_state->lock);
+    m_state->done = true;
+    m_state->condition.notify_all();
+    return res;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection* conn)
@@ -127,15 +160,34 @@ bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
         return false;
     }
 
-    if (m_queries[index].first != NULL)
+    if (m_queries[index].IsPending())
     {
         sLog.outError("Attempt assign query to holder index (" SIZEFMTD ") where other query stored (Old: [%s] New: [%s])",
-                      index, m_queries[index].first, sql);
+                      index, m_queries[index].sql ? m_queries[index].sql : "prepared statement", sql);
         return false;
     }
 
     /// not executed yet, just stored (it's not called a holder for nothing)
-    m_queries[index] = SqlResultPair(mangos_strdup(sql), (QueryResult*)NULL);
+    m_queries[index].sql = mangos_strdup(sql);
+    m_queries[index].result = NULL;
+    return true;
+}
+
+bool SqlQueryHolder::SetStmtQuery(size_t index, SqlStatement& stmt)
+{
+    SqlStmtParameters* params = stmt.detach();
+
+    if (m_queries.size() <= index || m_queries[index].IsPending() || params->boundParams() != stmt.arguments())
+    {
+        sLog.outError("Can't assign prepared statement %i to holder index (" SIZEFMTD ", size: " SIZEFMTD ") with %u of %u parameters bound",
+                      stmt.ID(), index, m_queries.size(), params->boundParams(), stmt.arguments());
+        delete params;
+        return false;
+    }
+
+    m_queries[index].stmtId = stmt.ID();
+    m_queries[index].params = params;
+    m_queries[index].result = NULL;
     return true;
 }
 
@@ -166,14 +218,20 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if (index < m_queries.size())
     {
+        SqlQueryEntry& entry = m_queries[index];
+
         /// the query strings are freed on the first GetResult or in the destructor
-        if (m_queries[index].first != NULL)
+        if (entry.sql != NULL)
         {
-            delete[](const_cast<char*>(m_queries[index].first));
-            m_queries[index].first = NULL;
+            delete[](const_cast<char*>(entry.sql));
+            entry.sql = NULL;
         }
+
+        delete entry.params;
+        entry.params = NULL;
+
         /// when you get a result aways remember to delete it!
-        return m_queries[index].second;
+        return entry.result;
     }
     else
         return NULL;
@@ -183,7 +241,7 @@ void SqlQueryHolder::SetResult(size_t index, QueryResult* result)
 {
     /// store the result in the holder
     if (index < m_queries.size())
-        m_queries[index].second = result;
+        m_queries[index].result = result;
 }
 
 SqlQueryHolder::~SqlQueryHolder()
@@ -192,10 +250,11 @@ SqlQueryHolder::~SqlQueryHolder()
     {
         /// if the result was never used, free the resources
         /// results used already (getresult called) are expected to be deleted
-        if (m_queries[i].first != NULL)
+        if (m_queries[i].IsPending())
         {
-            delete[](const_cast<char*>(m_queries[i].first));
-            delete m_queries[i].second;
+            delete[](const_cast<char*>(m_queries[i].sql));
+            delete m_queries[i].params;
+            delete m_queries[i].result;
         }
     }
 }
@@ -213,12 +272,15 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 
     LOCK_DB_CONN(conn);
     /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+    std::vector<SqlQueryHolder::SqlQueryEntry>& queries = m_holder->m_queries;
     for (size_t i = 0; i < queries.size(); ++i)
     {
         /// execute all queries in the holder and pass the results
-        char const* sql = queries[i].first;
-        if (sql) m_holder->SetResult(i, conn->Query(sql));
+        char const* sql = queries[i].sql;
+        if (sql)
+            m_holder->SetResult(i, conn->Query(sql));
+        else if (queries[i].params)
+            m_holder->SetResult(i, conn->QueryStmt(queries[i].stmtId, *queries[i].params));
     }
 
     /// sync with the caller thread
@@ -22,9 +22,12 @@
 #include "Common.h"
 
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/shared_ptr.hpp>
 #include "LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
+#include "SqlPreparedStatement.h"
 
 /// ---- BASE ---
 
@@ -38,6 +41,8 @@ class SqlOperation
     public:
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection* conn) = 0;
+        // plain writes without result, the delay thread may commit several of them in one transaction
+        virtual bool IsBatchable() const { return false; }
         virtual ~SqlOperation() {}
 };
 
@@ -51,6 +56,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 };
 
 class SqlTransaction : public SqlOperation
@@ -74,12 +80,50 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
 
     private:
         const int m_nIndex;
         SqlStmtParameters* m_param;
 };
 
+/// ---- LANE FENCES ----
+
+// A request keyed with two keys of different lanes is executed on the default async connection.
+// SqlFencedRequest waits there until the SqlLaneFences queued at the same time in the keys' lanes are reached,
+// these lanes then wait until the request is done. So the request keeps its place in all orders.
+struct SqlLaneFenceState
+{
+    SqlLaneFenceState(int fences) : pendingFences(fences), done(false) {}
+
+    boost::mutex lock;
+    boost::condition_variable condition;
+    int pendingFences;                                      // lanes still executing earlier requests
+    bool done;                                              // the fenced request is executed
+};
+
+typedef boost::shared_ptr<SqlLaneFenceState> SqlLaneFenceStatePtr;
+
+class SqlLaneFence : public SqlOperation
+{
+    private:
+        SqlLaneFenceStatePtr m_state;
+    public:
+        SqlLaneFence(SqlLaneFenceStatePtr state) : m_state(state) {}
+        bool Execute(SqlConnection* conn) override;
+};
+
+class SqlFencedRequest : public SqlOperation
+{
+    private:
+        SqlOperation* m_op;
+        SqlLaneFenceStatePtr m_state;
+    public:
+        SqlFencedRequest(SqlOperation* op, SqlLaneFenceStatePtr state) : m_op(op), m_state(state) {}
+        ~SqlFencedRequest() { delete m_op; }
+        bool Execute(SqlConnection* conn) override;
+};
+
 /// ---- ASYNC QUERIES ----
 
 class SqlQuery;                                             /// contains a single async query
@@ -112,13 +156,41 @@ class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
     private:
-        typedef std::pair<const char*, QueryResult*> SqlResultPair;
-        std::vector<SqlResultPair> m_queries;
+        struct SqlQueryEntry
+        {
+            SqlQueryEntry() : sql(NULL), stmtId(-1), params(NULL), result(NULL) {}
+
+            // not fetched by GetResult yet
+            bool IsPending() const { return sql != NULL || params != NULL; }
+
+            const char* sql;                                // plain query
+            int stmtId;                                     // or prepared statement with its parameters
+            SqlStmtParameters* params;
+            QueryResult* result;
+        };
+        std::vector<SqlQueryEntry> m_queries;
     public:
         SqlQueryHolder() {}
         ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
+        // prepared statement query, all parameters must be bound already
+        bool SetStmtQuery(size_t index, SqlStatement& stmt);
+
+        template<typename ParamType1>
+        bool SetPStmtQuery(size_t index, SqlStatement stmt, ParamType1 param1)
+        {
+            stmt.arg(param1);
+            return SetStmtQuery(index, stmt);
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        bool SetPStmtQuery(size_t index, SqlStatement stmt, ParamType1 param1, ParamType2 param2)
+        {
+            stmt.arg(param1);
+            stmt.arg(param2);
+            return SetStmtQuery(index, stmt);
+        }
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult* result);
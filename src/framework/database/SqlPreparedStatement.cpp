@@ -81,6 +81,22 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters* args = detach();
+    // verify amount of bound parameters
+    if (args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return NULL;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 SqlPlainPreparedStatement::SqlPlainPreparedStatement(const std::string& fmt, SqlConnection& conn) : SqlPreparedStatement(fmt, conn)
 {
@@ -131,6 +147,15 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if (m_szPlainRequest.empty())
+        return NULL;
+
+    // no binary protocol here, the DBMS returns text results
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt)
 {
     switch (data.type())
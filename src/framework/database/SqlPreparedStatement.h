@@ -205,6 +205,8 @@ class MANGOS_DLL_SPEC SqlStatement
 
         bool Execute();
         bool DirectExecute();
+        // synchronous query, the caller owns the result
+        QueryResult* Query();
 
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -241,6 +243,30 @@ class MANGOS_DLL_SPEC SqlStatement
             return Execute();
         }
 
+        template<typename ParamType1>
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
         // bind parameters with specified type
         void addBool(bool var) { arg(var); }
         void addUInt8(uint8 var) { arg(var); }
@@ -260,6 +286,7 @@ class MANGOS_DLL_SPEC SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlQueryHolder;
         SqlStatement(const SqlStatementID& index, Database& db) : m_index(index), m_pDB(&db), m_pParams(NULL) {}
 
     private:
@@ -313,6 +340,8 @@ class MANGOS_DLL_SPEC SqlPreparedStatement
 
         // execute statement w/o result set
         virtual bool execute() = 0;
+        // execute query statement, returns NULL if there are no rows like Database::Query()
+        virtual QueryResult* query() = 0;
 
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) :
@@ -342,6 +371,7 @@ class MANGOS_DLL_SPEC SqlPlainPreparedStatement : public SqlPreparedStatement
         virtual void bind(const SqlStmtParameters& holder) override;
 
         virtual bool execute() override;
+        virtual QueryResult* query() override;
 
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt);
@@ -317,6 +317,7 @@ class ByteBuffer
         const uint8* contents() const { return &_storage[0]; }
 
         size_t size() const { return _storage.size(); }
+        size_t capacity() const { return _storage.capacity(); }
         bool empty() const { return _storage.empty(); }
 
         void resize(size_t newsize)
@@ -354,9 +355,15 @@ class ByteBuffer
 
             MANGOS_ASSERT(size() < 10000000);
 
-            if (_storage.size() < _wpos + cnt)
-                _storage.resize(_wpos + cnt);
-            memcpy(&_storage[_wpos], src, cnt);
+            // packets are mostly built from front to back, copy straight to the end without zero filling first
+            if (_wpos == _storage.size())
+                _storage.insert(_storage.end(), src, src + cnt);
+            else
+            {
+                if (_storage.size() < _wpos + cnt)
+                    _storage.resize(_wpos + cnt);
+                memcpy(&_storage[_wpos], src, cnt);
+            }
             _wpos += cnt;
         }
 
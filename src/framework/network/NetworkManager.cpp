@@ -88,6 +88,28 @@ void NetworkManager::StopNetwork()
     }
 }
 
+long NetworkManager::GetOutgoingOverflowBuffers() const
+{
+    long count = 0;
+
+    if (network_threads_)
+        for (size_t i = 0; i < network_threads_count_; ++i)
+            count += network_threads_[i].OverflowBuffers();
+
+    return count;
+}
+
+long NetworkManager::GetOutgoingOverflowDisconnects() const
+{
+    long count = 0;
+
+    if (network_threads_)
+        for (size_t i = 0; i < network_threads_count_; ++i)
+            count += network_threads_[i].OverflowDisconnects();
+
+    return count;
+}
+
 bool NetworkManager::OnSocketOpen(const SocketPtr& socket)
 {
     NetworkThread& thread = socket->owner();
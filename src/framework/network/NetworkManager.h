@@ -36,6 +36,10 @@ public:
     const std::string& GetBindAddress() { return address_; }
     boost::uint16_t GetBindPort() { return port_; }
 
+    // outgoing queue statistics summed over all network threads
+    long GetOutgoingOverflowBuffers() const;
+    long GetOutgoingOverflowDisconnects() const;
+
 protected:
     NetworkManager();
     virtual ~NetworkManager();
@@ -17,9 +17,13 @@
  */
 
 #include "NetworkThread.h"
+#include "NetworkBuffer.h"
 #include "Database/DatabaseEnv.h"
 
-NetworkThread::NetworkThread() : connections_(0)
+// Max amount of free outgoing chunks kept per network thread
+static const size_t MAX_POOLED_BUFFERS = 64;
+
+NetworkThread::NetworkThread() : connections_(0), overflow_buffers_(0), overflow_disconnects_(0)
 {
 
 }
@@ -27,6 +31,12 @@ NetworkThread::NetworkThread() : connections_(0)
 NetworkThread::~NetworkThread()
 {
     Stop();
+
+    // sockets give their outgoing buffers back to the pool on destruction
+    sockets_.clear();
+
+    for (BufferPool::iterator itr = buffer_pool_.begin(); itr != buffer_pool_.end(); ++itr)
+        delete *itr;
 }
 
 void NetworkThread::Start()
@@ -61,6 +71,44 @@ void NetworkThread::RemoveSocket(const SocketPtr& socket)
     sockets_.erase(socket);
 }
 
+NetworkBuffer* NetworkThread::AcquireBuffer(uint32 size)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(buffer_pool_mutex_);
+
+        while (!buffer_pool_.empty())
+        {
+            NetworkBuffer* buffer = buffer_pool_.back();
+            buffer_pool_.pop_back();
+
+            if (buffer->capacity() == size)
+                return buffer;
+
+            // outgoing buffer size was changed, drop old sized chunks
+            delete buffer;
+        }
+    }
+
+    return new NetworkBuffer(size);
+}
+
+void NetworkThread::ReleaseBuffer(NetworkBuffer* buffer)
+{
+    buffer->Reset();
+
+    {
+        boost::lock_guard<boost::mutex> lock(buffer_pool_mutex_);
+
+        if (buffer_pool_.size() < MAX_POOLED_BUFFERS)
+        {
+            buffer_pool_.push_back(buffer);
+            return;
+        }
+    }
+
+    delete buffer;
+}
+
 void NetworkThread::Work()
 {
     DEBUG_LOG("Network Thread Starting");
@@ -20,10 +20,14 @@
 #define NETWORK_THREAD_H
 
 #include <set>
+#include <vector>
 #include <boost/thread.hpp>
 #include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
 #include "ProtocolDefinitions.h"
 
+class NetworkBuffer;
+
 class NetworkThread : public boost::noncopyable
 {
 public:
@@ -40,6 +44,16 @@ public:
     long Connections() const { return connections_; }
     protocol::Service& service() { return service_; }
 
+    // Pool of outgoing buffer chunks shared by the sockets of this thread
+    NetworkBuffer* AcquireBuffer(uint32 size);
+    void ReleaseBuffer(NetworkBuffer* buffer);
+
+    // Outgoing queue statistics
+    long OverflowBuffers() const { return overflow_buffers_; }
+    long OverflowDisconnects() const { return overflow_disconnects_; }
+    void OnOutgoingOverflow() { ++overflow_buffers_; }
+    void OnOutgoingLimitReached() { ++overflow_disconnects_; }
+
 private:
     virtual void Work();
 
@@ -47,6 +61,12 @@ private:
     SocketSet sockets_;
 
     boost::atomic_long connections_;
+    boost::atomic_long overflow_buffers_;
+    boost::atomic_long overflow_disconnects_;
+
+    typedef std::vector<NetworkBuffer*> BufferPool;
+    BufferPool buffer_pool_;
+    boost::mutex buffer_pool_mutex_;
 
     protocol::Service service_;
     std::auto_ptr<protocol::Service::work> service_work_;
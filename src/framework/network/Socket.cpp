@@ -28,7 +28,9 @@
 const std::string Socket::UNKNOWN_NETWORK_ADDRESS = "<unknown>";
 
 Socket::Socket(NetworkManager& manager, NetworkThread& owner) : manager_(manager), owner_(owner), socket_(owner.service()),
-    outgoing_buffer_size_(protocol::SEND_BUFFER_SIZE), write_operation_(false), closed_(true), address_(UNKNOWN_NETWORK_ADDRESS)
+    direct_read_data_(nullptr), direct_read_size_(0),
+    outgoing_buffer_size_(protocol::SEND_BUFFER_SIZE), outgoing_queue_limit_(0), outgoing_queued_(0),
+    write_operation_(false), closed_(true), address_(UNKNOWN_NETWORK_ADDRESS)
 {
 
 }
@@ -36,6 +38,7 @@ Socket::Socket(NetworkManager& manager, NetworkThread& owner) : manager_(manager
 Socket::~Socket(void)
 {
     Close();
+    ReleaseOutgoingBuffers();
 }
 
 void Socket::CloseSocket(void)
@@ -50,7 +53,7 @@ void Socket::CloseSocket(void)
 
 bool Socket::Open()
 {
-    if (out_buffer_.get())
+    if (!out_queue_.empty())
         return false;
 
     address_ = ObtainRemoteAddress();
@@ -62,7 +65,7 @@ bool Socket::Open()
 
     closed_ = false;
 
-    out_buffer_.reset(new NetworkBuffer(outgoing_buffer_size_));
+    out_queue_.push_back(owner_.AcquireBuffer(outgoing_buffer_size_));
     read_buffer_.reset(new NetworkBuffer(protocol::READ_BUFFER_SIZE));
 
     StartAsyncRead();
@@ -126,6 +129,71 @@ void Socket::SetOutgoingBufferSize(size_t size)
     outgoing_buffer_size_ = size;
 }
 
+void Socket::SetOutgoingQueueLimit(size_t limit)
+{
+    outgoing_queue_limit_ = limit;
+}
+
+bool Socket::CanQueueOutgoing(size_t n) const
+{
+    return !outgoing_queue_limit_ || outgoing_queued_ + n <= outgoing_queue_limit_;
+}
+
+void Socket::QueueOutgoing(const uint8* data, size_t n)
+{
+    MANGOS_ASSERT(!out_queue_.empty());
+
+    outgoing_queued_ += n;
+
+    while (n > 0)
+    {
+        NetworkBuffer* buffer = out_queue_.back();
+
+        if (buffer->space() == 0)
+        {
+            buffer = owner_.AcquireBuffer(outgoing_buffer_size_);
+            out_queue_.push_back(buffer);
+            owner_.OnOutgoingOverflow();
+        }
+
+        size_t chunk = std::min<size_t>(n, buffer->space());
+        if (!buffer->Write(data, chunk))
+            MANGOS_ASSERT(false);
+
+        // extend the last segment if it is on the same chunk
+        if (out_segments_.empty() || out_segments_.back().buffer_ != buffer)
+            out_segments_.push_back(OutgoingSegment(buffer));
+        out_segments_.back().length_ += chunk;
+
+        data += chunk;
+        n -= chunk;
+    }
+}
+
+void Socket::QueueOutgoing(const SharedPayload& payload)
+{
+    MANGOS_ASSERT(!out_queue_.empty());
+
+    if (payload->empty())
+        return;
+
+    outgoing_queued_ += payload->size();
+
+    out_segments_.push_back(OutgoingSegment(payload));
+}
+
+void Socket::ReleaseOutgoingBuffers()
+{
+    GuardType Lock(out_buffer_lock_);
+
+    for (OutgoingQueue::iterator itr = out_queue_.begin(); itr != out_queue_.end(); ++itr)
+        owner_.ReleaseBuffer(*itr);
+
+    out_queue_.clear();
+    out_segments_.clear();
+    outgoing_queued_ = 0;
+}
+
 uint32 Socket::native_handle() 
 {
     return uint32(socket_.native_handle());
@@ -138,16 +206,40 @@ void Socket::StartAsyncSend()
 
     if (write_operation_)
         return;
-    
-    if (out_buffer_->length() == 0)
-    {
-        write_operation_ = false;
+
+    if (outgoing_queued_ == 0)
         return;
+
+    // gather everything queued so far into a single write
+    std::vector<boost::asio::const_buffer> sequence;
+    sequence.reserve(out_segments_.size());
+
+    const NetworkBuffer* buffer = nullptr;
+    const uint8* copied = nullptr;                          // next unsent copied byte of buffer
+
+    for (SegmentQueue::const_iterator itr = out_segments_.begin(); itr != out_segments_.end(); ++itr)
+    {
+        if (itr->buffer_)
+        {
+            if (itr->buffer_ != buffer)
+            {
+                buffer = itr->buffer_;
+                copied = buffer->read_data();
+            }
+
+            sequence.push_back(boost::asio::const_buffer(copied, itr->length_));
+            copied += itr->length_;
+        }
+        else
+        {
+            const ByteBuffer& payload = *itr->payload_;
+            sequence.push_back(boost::asio::const_buffer(payload.contents() + payload.size() - itr->length_, itr->length_));
+        }
     }
 
     write_operation_ = true;
 
-    socket_.async_write_some(boost::asio::buffer(out_buffer_->read_data(), out_buffer_->length()),
+    boost::asio::async_write(socket_, sequence,
         boost::bind(&Socket::OnWriteComplete, shared_from_this(), boost::asio::placeholders::error,
         boost::asio::placeholders::bytes_transferred));
 }
@@ -163,17 +255,58 @@ void Socket::OnWriteComplete(const boost::system::error_code& error, size_t byte
     GuardType Lock(out_buffer_lock_);
 
     write_operation_ = false;
-    out_buffer_->Consume(bytes_transferred);
-    out_buffer_->Prepare();
+    outgoing_queued_ -= bytes_transferred;
+
+    while (bytes_transferred > 0)
+    {
+        MANGOS_ASSERT(!out_segments_.empty());
+
+        OutgoingSegment& segment = out_segments_.front();
+        size_t chunk = std::min<size_t>(bytes_transferred, segment.length_);
+
+        if (segment.buffer_)
+            segment.buffer_->Consume(chunk);
+
+        segment.length_ -= chunk;
+        bytes_transferred -= chunk;
+
+        // a sent payload is released here, the last socket sending it frees it
+        if (segment.length_ == 0)
+            out_segments_.pop_front();
+    }
+
+    // give fully sent chunks back to the pool, the last one is kept for new data
+    while (out_queue_.size() > 1 && out_queue_.front()->length() == 0)
+    {
+        owner_.ReleaseBuffer(out_queue_.front());
+        out_queue_.pop_front();
+    }
+
+    if (out_queue_.size() == 1)
+        out_queue_.front()->Prepare();
 
     StartAsyncSend();
 }
 
+void Socket::ReadDirect(uint8* data, size_t n)
+{
+    direct_read_data_ = data;
+    direct_read_size_ = n;
+}
+
 void Socket::StartAsyncRead()
 {
     if (IsClosed())
         return;
 
+    if (direct_read_size_ > 0)
+    {
+        boost::asio::async_read(socket_, boost::asio::buffer(direct_read_data_, direct_read_size_),
+            boost::bind(&Socket::OnDirectReadComplete, shared_from_this(), boost::asio::placeholders::error,
+            boost::asio::placeholders::bytes_transferred));
+        return;
+    }
+
     read_buffer_->Prepare();
 
     socket_.async_read_some(boost::asio::buffer(read_buffer_->write_data(), read_buffer_->space()),
@@ -203,6 +336,26 @@ void Socket::OnReadComplete(const boost::system::error_code& error, size_t bytes
     StartAsyncRead();
 }
 
+void Socket::OnDirectReadComplete(const boost::system::error_code& error, size_t /*bytes_transferred*/)
+{
+    if (error)
+    {
+        OnError(error);
+        return;
+    }
+
+    direct_read_data_ = nullptr;
+    direct_read_size_ = 0;
+
+    if (!ProcessDirectReadData())
+    {
+        CloseSocket();
+        return;
+    }
+
+    StartAsyncRead();
+}
+
 void Socket::OnError(const boost::system::error_code& error)
 {
     if (!error)
@@ -19,11 +19,14 @@
 #ifndef SOCKET_H
 #define SOCKET_H
 
+#include <deque>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/lock_guard.hpp>
 #include "NetworkBuffer.h"
 #include "ProtocolDefinitions.h"
+#include "ByteBuffer.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #   pragma once
@@ -41,6 +44,9 @@ class Socket : public boost::enable_shared_from_this<Socket>
 public:
     friend class NetworkManager;
 
+    // Immutable data queued on several sockets at once, e.g. the body of a broadcast packet
+    typedef boost::shared_ptr<ByteBuffer const> SharedPayload;
+
     Socket(NetworkManager& manager, NetworkThread& owner);
     virtual ~Socket(void);
 
@@ -52,6 +58,9 @@ public:
     bool EnableTCPNoDelay(bool enable);
     bool SetSendBufferSize(int size);
     void SetOutgoingBufferSize(size_t size);
+    void SetOutgoingQueueLimit(size_t limit);
+
+    size_t GetOutgoingQueueSize() const { return outgoing_queued_; }
 
     protocol::Socket& socket() { return socket_; }
     NetworkThread& owner() { return owner_; }
@@ -61,13 +70,25 @@ protected:
     void StartAsyncSend();
     virtual bool ProcessIncomingData() = 0;
 
+    // Next n bytes of the stream are read straight into data instead of read_buffer_,
+    // ProcessDirectReadData() is called once all of them arrived
+    void ReadDirect(uint8* data, size_t n);
+    virtual bool ProcessDirectReadData() { return true; }
+
     uint32 native_handle();
 
+    // Outgoing queue helpers, out_buffer_lock_ must be held by the caller
+    // false before Open() and once the socket is closed, nothing queued then would ever be sent
+    bool IsOpenForSending() const { return !closed_ && !out_queue_.empty(); }
+    bool CanQueueOutgoing(size_t n) const;
+    void QueueOutgoing(const uint8* data, size_t n);
+    // the payload is referenced until it is sent instead of copied, it must not be modified anymore
+    void QueueOutgoing(const SharedPayload& payload);
+
     typedef boost::mutex LockType;
     typedef boost::lock_guard<LockType> GuardType;
     LockType out_buffer_lock_;
 
-    std::auto_ptr<NetworkBuffer> out_buffer_;
     std::auto_ptr<NetworkBuffer> read_buffer_;
 
     NetworkManager& manager_;
@@ -79,12 +100,42 @@ private:
 
     void OnWriteComplete(const boost::system::error_code& error, size_t bytes_transferred);
     void OnReadComplete(const boost::system::error_code& error, size_t bytes_transferred);
+    void OnDirectReadComplete(const boost::system::error_code& error, size_t bytes_transferred);
     void OnError(const boost::system::error_code& error);
 
     std::string ObtainRemoteAddress() const;
 
+    void ReleaseOutgoingBuffers();
+
     protocol::Socket socket_;
+
+    uint8* direct_read_data_;
+    size_t direct_read_size_;
+
+    // Outgoing data is kept in a chain of fixed size chunks taken from the owner thread pool.
+    // New data is appended to the back chunk, the front chunks are being sent with one gather write.
+    typedef std::deque<NetworkBuffer*> OutgoingQueue;
+    OutgoingQueue out_queue_;
+
+    // Send order of the queued data, copied bytes in the chunks interleaved with shared payloads.
+    // Copied bytes are sent in the order they were written, so a segment on a chunk starts where
+    // the earlier unsent segments on the same chunk end.
+    struct OutgoingSegment
+    {
+        OutgoingSegment(NetworkBuffer* buffer) : buffer_(buffer), length_(0) {}
+        OutgoingSegment(const SharedPayload& payload) : buffer_(nullptr), payload_(payload), length_(payload->size()) {}
+
+        NetworkBuffer* buffer_;                             // chunk of the copied bytes, nullptr for a payload
+        SharedPayload payload_;
+        size_t length_;                                     // bytes not sent yet
+    };
+
+    typedef std::deque<OutgoingSegment> SegmentQueue;
+    SegmentQueue out_segments_;
+
     size_t outgoing_buffer_size_;
+    size_t outgoing_queue_limit_;
+    size_t outgoing_queued_;
     std::string address_;
     bool write_operation_;
     bool closed_;
@@ -23,28 +23,60 @@
 #include "ByteBuffer.h"
 #include "Opcodes.h"
 
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+
 // Note: opcode_ and size stored in platfom dependent format
 // Ignore endianess until send, and converted at receive
 class WorldPacket : public ByteBuffer
 {
 public:
-    WorldPacket() : ByteBuffer(0), opcode_(MSG_NULL_ACTION) { }
-    explicit WorldPacket(Opcodes opcode, size_t res = 200) : ByteBuffer(res), opcode_(opcode) { }
-    WorldPacket(const WorldPacket& packet) : ByteBuffer(packet), opcode_(packet.opcode_) { }
+    WorldPacket() : ByteBuffer(0), opcode_(MSG_NULL_ACTION), initialCapacity_(0), sent_(false) { }
+    // the reserve is raised to the size packets of this opcode were recently sent with, see PredictPacketSize
+    explicit WorldPacket(Opcodes opcode, size_t res = 200) : ByteBuffer(PredictPacketSize(opcode, res)), opcode_(opcode), initialCapacity_(capacity()), sent_(false) { }
+    WorldPacket(const WorldPacket& packet) : ByteBuffer(packet), opcode_(packet.opcode_), initialCapacity_(capacity()), sent_(false) { }
+    WorldPacket& operator=(const WorldPacket& packet)
+    {
+        ByteBuffer::operator=(packet);
+        opcode_ = packet.opcode_;
+        initialCapacity_ = capacity();
+        sendForm_.reset();
+        sent_ = false;
+        return *this;
+    }
 
     void Initialize(Opcodes opcode, size_t newres = 200)
     {
         clear();
-        _storage.reserve(newres);
+        _storage.reserve(PredictPacketSize(opcode, newres));
         opcode_ = opcode;
+        initialCapacity_ = capacity();
+        sendForm_.reset();
+        sent_ = false;
     }
 
     Opcodes GetOpcode() const { return opcode_; }
     void SetOpcode(Opcodes opcode) { opcode_ = opcode; }
     inline const char* GetOpcodeName() const { return LookupOpcodeName(opcode_); }
 
+    // storage had to grow while the packet was built
+    bool IsOutgrown() const { return capacity() > initialCapacity_; }
+
+    // true only for the first socket the packet is sent to, so its size is recorded once, see RecordSentPacket
+    bool MarkSent() const { return !sent_.exchange(true, boost::memory_order_relaxed); }
+
+    // the packet as it goes on the wire (compressed), prepared once for all sockets a shared packet is sent to
+    boost::shared_ptr<WorldPacket const> GetSendForm() const { return boost::atomic_load(&sendForm_); }
+    void SetSendForm(const boost::shared_ptr<WorldPacket const>& form) const { boost::atomic_store(&sendForm_, form); }
+
 protected:
     Opcodes opcode_;
+    size_t initialCapacity_;
+    mutable boost::shared_ptr<WorldPacket const> sendForm_;
+    mutable boost::atomic<bool> sent_;
 };
 
+// Packet sent to several sessions, the sockets reference its payload until it is sent
+typedef boost::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 #endif // WORLD_PACKET_H
\ No newline at end of file
@@ -82,6 +82,9 @@ bool ArenaTeam::Create(ObjectGuid captainGuid, ArenaType type, std::string arena
 
     m_TeamId = sObjectMgr.GenerateArenaTeamId();
 
+    // the rows of an arena team are written in order on the async connection of the team
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     // ArenaTeamName already assigned to ArenaTeam::name, use it to encode string for DB
     CharacterDatabase.escape_string(arenaTeamName);
 
@@ -102,6 +105,8 @@ bool ArenaTeam::Create(ObjectGuid captainGuid, ArenaType type, std::string arena
 
 bool ArenaTeam::AddMember(ObjectGuid playerGuid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     std::string plName;
     uint8 plClass;
 
@@ -286,6 +291,8 @@ bool ArenaTeam::LoadMembersFromDB(QueryResult* arenaTeamMembersResult)
 
 void ArenaTeam::SetCaptain(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     // disable remove/promote buttons
     Player* oldcaptain = sObjectMgr.GetPlayer(GetCaptainGuid());
     if (oldcaptain)
@@ -304,6 +311,8 @@ void ArenaTeam::SetCaptain(ObjectGuid guid)
 
 void ArenaTeam::DelMember(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     for (MemberList::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
         if (itr->guid == guid)
@@ -326,6 +335,8 @@ void ArenaTeam::DelMember(ObjectGuid guid)
 
 void ArenaTeam::Disband(WorldSession* session)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     // event
     if (session)
     {
@@ -445,6 +456,8 @@ void ArenaTeam::InspectStats(WorldSession* session, ObjectGuid guid)
 
 void ArenaTeam::SetEmblem(uint32 backgroundColor, uint32 emblemStyle, uint32 emblemColor, uint32 borderStyle, uint32 borderColor)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     m_BackgroundColor = backgroundColor;
     m_EmblemStyle = emblemStyle;
     m_EmblemColor = emblemColor;
@@ -456,6 +469,8 @@ void ArenaTeam::SetEmblem(uint32 backgroundColor, uint32 emblemStyle, uint32 emb
 
 void ArenaTeam::SetStats(uint32 stat_type, uint32 value)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     switch (stat_type)
     {
         case STAT_TYPE_RATING:
@@ -745,6 +760,8 @@ void ArenaTeam::UpdateArenaPointsHelper(std::map<uint32, uint32>& PlayerPoints)
 
 void ArenaTeam::SaveToDB()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_TeamId);
+
     // save team and member stats to db
     // called after a match has ended, or when calculating arena_points
     CharacterDatabase.BeginTransaction();
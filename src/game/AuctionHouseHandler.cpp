@@ -515,6 +515,7 @@ void WorldSession::HandleAuctionRemoveItem(WorldPacket& recv_data)
     // inform player, that auction is removed
     SendAuctionCommandResult(auction, AUCTION_REMOVED, AUCTION_OK);
     // Now remove the auction
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0, GetAccountId());
     CharacterDatabase.BeginTransaction();
     auction->DeleteFromDB();
     pl->SaveInventoryAndGoldToDB();
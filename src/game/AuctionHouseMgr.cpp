@@ -920,6 +920,8 @@ AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHou
 
     sAuctionMgr.AddAItem(newItem);
 
+    // auctions are written on the default async connection, the item leaves the account of the seller
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0, pl ? pl->GetSession()->GetAccountId() : 0);
     CharacterDatabase.BeginTransaction();
 
     newItem->SaveToDB();
@@ -983,6 +985,8 @@ uint32 AuctionEntry::GetAuctionOutBid() const
 
 void AuctionEntry::DeleteFromDB() const
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     // No SQL injection (Id is integer)
     CharacterDatabase.PExecute("DELETE FROM auction WHERE id = '%u'", Id);
 }
@@ -997,6 +1001,8 @@ void AuctionEntry::SaveToDB() const
 
 void AuctionEntry::AuctionBidWinning(Player* newbidder)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0, newbidder ? newbidder->GetSession()->GetAccountId() : 0);
+
     moneyDeliveryTime = time(NULL) + HOUR;
 
     CharacterDatabase.BeginTransaction();
@@ -1010,6 +1016,9 @@ void AuctionEntry::AuctionBidWinning(Player* newbidder)
 
 bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=NULL*/)
 {
+    // the money of the bidder goes to the auction, see AuctionHouseObject::AddAuction
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0, newbidder ? newbidder->GetSession()->GetAccountId() : 0);
+
     Player* auction_owner = owner ? sObjectMgr.GetPlayer(ObjectGuid(HIGHGUID_PLAYER, owner)) : NULL;
 
     // bid can't be greater buyout
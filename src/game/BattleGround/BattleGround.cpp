@@ -459,13 +459,14 @@ void BattleGround::SetTeamStartLoc(Team team, float X, float Y, float Z, float O
 
 void BattleGround::SendPacketToAll(WorldPacket* packet)
 {
+    BroadcastPacket broadcast(packet);
     for (BattleGroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.OfflineRemoveTime)
             continue;
 
         if (Player* plr = sObjectMgr.GetPlayer(itr->first))
-            plr->GetSession()->SendPacket(packet);
+            broadcast.SendTo(plr->GetSession());
         else
             sLog.outError("BattleGround:SendPacketToAll: %s not found!", itr->first.GetString().c_str());
     }
@@ -473,6 +474,7 @@ void BattleGround::SendPacketToAll(WorldPacket* packet)
 
 void BattleGround::SendPacketToTeam(Team teamId, WorldPacket* packet, Player* sender, bool self)
 {
+    BroadcastPacket broadcast(packet);
     for (BattleGroundPlayerMap::const_iterator itr = m_Players.begin(); itr != m_Players.end(); ++itr)
     {
         if (itr->second.OfflineRemoveTime)
@@ -492,7 +494,7 @@ void BattleGround::SendPacketToTeam(Team teamId, WorldPacket* packet, Player* se
         if (!team) team = plr->GetTeam();
 
         if (team == teamId)
-            plr->GetSession()->SendPacket(packet);
+            broadcast.SendTo(plr->GetSession());
     }
 }
 
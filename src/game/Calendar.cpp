@@ -66,6 +66,8 @@ CalendarInvite* CalendarEvent::GetInviteByGuid(ObjectGuid const& guid)
 // remove invite by its iterator
 void CalendarEvent::RemoveInviteByItr(CalendarInviteMap::iterator inviteItr)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     MANGOS_ASSERT(inviteItr != m_Invitee.end());    // iterator must be valid
 
     if (!IsGuildEvent())
@@ -249,6 +251,9 @@ void CalendarMgr::GetPlayerInvitesList(ObjectGuid const& guid, CalendarInvitesLi
 CalendarEvent* CalendarMgr::AddEvent(ObjectGuid const& guid, std::string title, std::string description, uint32 type, uint32 repeatable,
                                      uint32 maxInvites, int32 dungeonId, time_t eventTime, time_t /*unkTime*/, uint32 flags)
 {
+    // calendar rows are changed from the sessions of all invitees, they are written on the default async connection
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     Player* player = sObjectMgr.GetPlayer(guid);
     if (!player)
         return NULL;
@@ -328,6 +333,8 @@ CalendarEvent* CalendarMgr::AddEvent(ObjectGuid const& guid, std::string title,
 // some check done before so it may fail and raison is sent to client
 void CalendarMgr::RemoveEvent(uint64 eventId, Player* remover)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     CalendarEventStore::iterator citr = m_EventStore.find(eventId);
     if (citr == m_EventStore.end())
     {
@@ -356,6 +363,8 @@ void CalendarMgr::RemoveEvent(uint64 eventId, Player* remover)
 // return value is the CalendarInvite pointer on success
 CalendarInvite* CalendarMgr::AddInvite(CalendarEvent* event, ObjectGuid const& senderGuid, ObjectGuid const& inviteeGuid, CalendarInviteStatus status, CalendarModerationRank rank, std::string text, time_t statusTime)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     Player* sender = sObjectMgr.GetPlayer(senderGuid);
     if (!event || !sender)
         return NULL;
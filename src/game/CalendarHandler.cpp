@@ -365,6 +365,8 @@ void WorldSession::HandleCalendarUpdateEvent(WorldPacket& recv_data)
         // query construction
         CharacterDatabase.escape_string(title);
         CharacterDatabase.escape_string(description);
+        // see CalendarMgr::AddEvent
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
         CharacterDatabase.PExecute("UPDATE calendar_events SET "
                                    "type=%hu, flags=%u, dungeonId=%d, eventTime=%u, title='%s', description='%s'"
                                    "WHERE eventid=" UI64FMTD,
@@ -557,6 +559,7 @@ void WorldSession::HandleCalendarEventRsvp(WorldPacket& recv_data)
             invite->Status = CalendarInviteStatus(status);
             invite->LastUpdateTime = time(NULL);
 
+            Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
             CharacterDatabase.PExecute("UPDATE calendar_invites SET status=%u, lastUpdateTime=%u WHERE inviteId = "UI64FMTD, status, uint32(invite->LastUpdateTime), invite->InviteId);
             sCalendarMgr.SendCalendarEventStatus(invite);
             sCalendarMgr.SendCalendarClearPendingAction(_player);
@@ -630,6 +633,7 @@ void WorldSession::HandleCalendarEventStatus(WorldPacket& recv_data)
             invite->Status = (CalendarInviteStatus)status;
             invite->LastUpdateTime = time(NULL);            // not sure if we should set response time when moderator changes invite status
 
+            Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
             CharacterDatabase.PExecute("UPDATE calendar_invites SET status=%u, lastUpdateTime=%u WHERE inviteId=" UI64FMTD, status, uint32(invite->LastUpdateTime), invite->InviteId);
             sCalendarMgr.SendCalendarEventStatus(invite);
             sCalendarMgr.SendCalendarClearPendingAction(sObjectMgr.GetPlayer(invitee));
@@ -684,6 +688,7 @@ void WorldSession::HandleCalendarEventModeratorStatus(WorldPacket& recv_data)
                 return;
             }
 
+            Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
             CharacterDatabase.PExecute("UPDATE calendar_invites SET rank = %u WHERE inviteId=" UI64FMTD, rank, invite->InviteId);
             invite->Rank = CalendarModerationRank(rank);
             sCalendarMgr.SendCalendarEventModeratorStatusAlert(invite);
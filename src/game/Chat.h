@@ -517,13 +517,16 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleSendMassMoneyCommand(char* args);
 
         bool HandleServerCorpsesCommand(char* args);
+        bool HandleServerDBStatsCommand(char* args);
         bool HandleServerExitCommand(char* args);
         bool HandleServerIdleRestartCommand(char* args);
         bool HandleServerIdleShutDownCommand(char* args);
         bool HandleServerInfoCommand(char* args);
         bool HandleServerLogFilterCommand(char* args);
         bool HandleServerLogLevelCommand(char* args);
+        bool HandleServerMapStatsCommand(char* args);
         bool HandleServerMotdCommand(char* args);
+        bool HandleServerNetStatsCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
         bool HandleServerRestartCommand(char* args);
         bool HandleServerSetMotdCommand(char* args);
@@ -625,6 +628,7 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleMmapLocCommand(char* args);
         bool HandleMmapLoadedTilesCommand(char* args);
         bool HandleMmapStatsCommand(char* args);
+        bool HandleMmapPathCacheCommand(char* args);
         bool HandleMmap(char* args);
         bool HandleMmapTestArea(char* args);
 
@@ -100,6 +100,9 @@ bool Corpse::Create(uint32 guidlow, Player* owner)
 
 void Corpse::SaveToDB()
 {
+    // corpses are written on the default async connection, also by the world cleanup
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     // bones should not be saved to DB (would be deleted on startup anyway)
     MANGOS_ASSERT(GetType() != CORPSE_BONES);
 
@@ -140,6 +143,8 @@ void Corpse::DeleteBonesFromWorld()
 
 void Corpse::DeleteFromDB()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     // bones should not be saved to DB (would be deleted on startup anyway)
     MANGOS_ASSERT(GetType() != CORPSE_BONES);
 
@@ -189,7 +189,13 @@ void Creature::RemoveCorpse()
 {
     // since pool system can fail to roll unspawned object, this one can remain spawned, so must set respawn nevertheless
     if (uint16 poolid = sPoolMgr.IsPartOfAPool<Creature>(GetGUIDLow()))
+    {
+        // done again after the cells updated side by side, the pool can spawn into any of them
+        if (GetMap()->DeferPoolUpdate(this))
+            return;
+
         sPoolMgr.UpdatePool<Creature>(*GetMap()->GetPersistentState(), poolid, GetGUIDLow());
+    }
 
     if (!IsInWorld())                                       // can be despawned by update pool
         return;
@@ -785,15 +791,9 @@ bool Creature::Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo cons
     if (!cPos.Relocate(this))
         return false;
 
-    // Notify the outdoor pvp script
-    if (OutdoorPvP* outdoorPvP = sOutdoorPvPMgr.GetScript(GetZoneId()))
-        outdoorPvP->HandleCreatureCreate(this);
-
-    // Notify the map's instance data.
-    // Only works if you create the object in it, not if it is moves to that map.
-    // Normally non-players do not teleport to other maps.
-    if (InstanceData* iData = GetMap()->GetInstanceData())
-        iData->OnCreatureCreate(this);
+    // Notify the outdoor pvp script and the map's instance data, after a concurrent cell phase if in one
+    if (!GetMap()->DeferCreateHooks(this))
+        InformCreateHooks();
 
     switch (GetCreatureInfo()->Rank)
     {
@@ -828,6 +828,19 @@ bool Creature::Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo cons
     return true;
 }
 
+void Creature::InformCreateHooks()
+{
+    // Notify the outdoor pvp script
+    if (OutdoorPvP* outdoorPvP = sOutdoorPvPMgr.GetScript(GetZoneId()))
+        outdoorPvP->HandleCreatureCreate(this);
+
+    // Notify the map's instance data.
+    // Only works if you create the object in it, not if it is moves to that map.
+    // Normally non-players do not teleport to other maps.
+    if (InstanceData* iData = GetMap()->GetInstanceData())
+        iData->OnCreatureCreate(this);
+}
+
 bool Creature::IsTrainerOf(Player* pPlayer, bool msg) const
 {
     if (!isTrainer())
@@ -495,6 +495,7 @@ class MANGOS_DLL_SPEC Creature : public Unit
         void RemoveFromWorld() override;
 
         bool Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo const* cinfo, Team team = TEAM_NONE, const CreatureData* data = NULL, GameEventCreatureData const* eventData = NULL);
+        virtual void InformCreateHooks();
         bool LoadCreatureAddon(bool reload);
         void SelectLevel(const CreatureInfo* cinfo, float percentHealth = 100.0f, float percentMana = 100.0f);
         void LoadEquipment(uint32 equip_entry, bool force = false);
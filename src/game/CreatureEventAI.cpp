@@ -672,9 +672,11 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             break;
         case ACTION_T_THREAT_ALL_PCT:
         {
-            ThreatList const& threatList = m_creature->getThreatManager().getThreatList();
-            for (ThreatList::const_iterator i = threatList.begin(); i != threatList.end(); ++i)
-                if (Unit* Temp = m_creature->GetMap()->GetUnit((*i)->getUnitGuid()))
+            // threat changes can add or remove refs of the list, iterate a copy
+            GuidVector guids;
+            m_creature->FillGuidsListFromThreatList(guids);
+            for (GuidVector::const_iterator i = guids.begin(); i != guids.end(); ++i)
+                if (Unit* Temp = m_creature->GetMap()->GetUnit(*i))
                     m_creature->getThreatManager().modifyThreatPercent(Temp, action.threat_all_pct.percent);
             break;
         }
@@ -324,6 +324,8 @@ void CreatureLinkingHolder::AddSlaveToHolder(Creature* pCreature)
     if (!pInfo)
         return;
 
+    Map::SharedStateGuard guard(*pCreature->GetMap());
+
     if (pInfo->mapId == INVALID_MAP_ID)                     // Guid case, store master->slaves for fast access
     {
         HolderMapBounds bounds = m_holderGuidMap.equal_range(pInfo->masterId);
@@ -382,6 +384,8 @@ void CreatureLinkingHolder::AddMasterToHolder(Creature* pCreature)
     if (!sCreatureLinkingMgr.IsLinkedMaster(pCreature))
         return;
 
+    Map::SharedStateGuard guard(*pCreature->GetMap());
+
     // Check, if already stored
     BossGuidMapBounds bounds = m_masterGuid.equal_range(pCreature->GetEntry());
     for (BossGuidMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
@@ -405,6 +409,10 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
     if (eventType == LINKING_EVENT_AGGRO && !pEnemy)
         return;
 
+    // Slaves and masters may be in a region updated by another thread
+    if (pSource->GetMap()->DeferCreatureLinkingEvent(eventType, pSource, pEnemy))
+        return;
+
     uint32 eventFlagFilter = 0;
     uint32 reverseEventFlagFilter = 0;
 
@@ -620,6 +628,7 @@ bool CreatureLinkingHolder::CanSpawn(Creature* pCreature)
     }
 
     // Search for nearby master
+    Map::SharedStateGuard guard(*pCreature->GetMap());
     BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
     for (BossGuidMap::iterator itr = finds.first; itr != finds.second; ++itr)
     {
@@ -648,6 +657,7 @@ bool CreatureLinkingHolder::TryFollowMaster(Creature* pCreature)
     Creature* pMaster = NULL;
     if (pInfo->mapId != INVALID_MAP_ID)                     // entry case
     {
+        Map::SharedStateGuard guard(*pCreature->GetMap());
         BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
         for (BossGuidMap::iterator itr = finds.first; itr != finds.second; ++itr)
         {
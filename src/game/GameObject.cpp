@@ -188,6 +188,17 @@ bool GameObject::Create(uint32 guidlow, uint32 name_id, Map* map, uint32 phaseMa
             break;
     }
 
+    // Notify the battleground or outdoor pvp script and the map's instance data, after a concurrent cell phase if in one
+    if (!map->DeferCreateHooks(this))
+        InformCreateHooks();
+
+    return true;
+}
+
+void GameObject::InformCreateHooks()
+{
+    Map* map = GetMap();
+
     // Notify the battleground or outdoor pvp script
     if (map->IsBattleGroundOrArena())
         ((BattleGroundMap*)map)->GetBG()->HandleGameObjectCreate(this);
@@ -199,8 +210,6 @@ bool GameObject::Create(uint32 guidlow, uint32 name_id, Map* map, uint32 phaseMa
     // Normally non-players do not teleport to other maps.
     if (InstanceData* iData = map->GetInstanceData())
         iData->OnObjectCreate(this);
-
-    return true;
 }
 
 void GameObject::Update(uint32 update_diff, uint32 p_time)
@@ -467,7 +476,8 @@ void GameObject::Update(uint32 update_diff, uint32 p_time)
 
             // if part of pool, let pool system schedule new spawn instead of just scheduling respawn
             if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(GetGUIDLow()))
-                sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetGUIDLow());
+                if (!GetMap()->DeferPoolUpdate(this, poolid))
+                    sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetGUIDLow());
 
             // can be not in world at pool despawn
             if (IsInWorld())
@@ -506,7 +516,10 @@ void GameObject::Delete()
     SetUInt32Value(GAMEOBJECT_FLAGS, GetGOInfo()->flags);
 
     if (uint16 poolid = sPoolMgr.IsPartOfAPool<GameObject>(GetGUIDLow()))
-        sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetGUIDLow());
+    {
+        if (!GetMap()->DeferPoolUpdate(this, poolid))
+            sPoolMgr.UpdatePool<GameObject>(*GetMap()->GetPersistentState(), poolid, GetGUIDLow());
+    }
     else
         AddObjectToRemoveList();
 }
@@ -1817,7 +1830,7 @@ void GameObject::UpdateCollisionState() const
     if (!m_model || !IsInWorld())
         return;
 
-    m_model->enable(IsCollisionEnabled() ? GetPhaseMask() : 0);
+    GetMap()->EnableGameObjectModel(*m_model, IsCollisionEnabled() ? GetPhaseMask() : 0);
 }
 
 void GameObject::UpdateModel()
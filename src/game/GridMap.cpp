@@ -30,15 +30,52 @@
 #include "Policies/Singleton.h"
 #include "Util.h"
 
+#include <boost/bind.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <algorithm>
+
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "v1.3";
+char const* MAP_ALIGNED_VERSION_MAGIC = "v1.4";       // v1.3 with sections aligned for memory mapping
 char const* MAP_AREA_MAGIC    = "AREA";
 char const* MAP_HEIGHT_MAGIC  = "MHGT";
 char const* MAP_LIQUID_MAGIC  = "MLIQ";
 
+// whole .map file mapped read only, the arrays of the GridMap point into it
+struct GridMapFileMapping
+{
+    explicit GridMapFileMapping(char const* filename) :
+        m_file(filename, boost::interprocess::read_only), m_region(m_file, boost::interprocess::read_only) {}
+
+    char const* GetData() const { return static_cast<char const*>(m_region.get_address()); }
+    size_t GetSize() const { return m_region.get_size(); }
+
+    boost::interprocess::file_mapping m_file;
+    boost::interprocess::mapped_region m_region;
+};
+
+// count elements of T at offset of the mapped file, NULL if the file is too short or the data misaligned
+template<class T>
+static T const* GetMappedArray(GridMapFileMapping const* mapping, size_t offset, size_t count)
+{
+    if (offset + count * sizeof(T) > mapping->GetSize() || offset % boost::alignment_of<T>::value != 0)
+        return NULL;
+
+    return reinterpret_cast<T const*>(mapping->GetData() + offset);
+}
+
+static bool IsAcceptableMapVersion(uint32 versionMagic)
+{
+    return versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) || versionMagic == *((uint32 const*)(MAP_ALIGNED_VERSION_MAGIC));
+}
+
 GridMap::GridMap()
 {
     m_flags = 0;
+    m_mapping = NULL;
 
     // Area data
     m_gridArea = 0;
@@ -80,9 +117,16 @@ bool GridMap::loadData(char* filename)
 
     fread(&header, sizeof(header), 1, in);
     if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
-            header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) &&
+            IsAcceptableMapVersion(header.versionMagic) &&
             IsAcceptableClientBuild(header.buildMagic))
     {
+        // aligned files are used in place, older ones or files that can't be mapped are read
+        if (header.versionMagic == *((uint32 const*)(MAP_ALIGNED_VERSION_MAGIC)) && mapData(filename, header))
+        {
+            fclose(in);
+            return m_mapping != NULL;
+        }
+
         // loadup area data
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
@@ -116,14 +160,59 @@ bool GridMap::loadData(char* filename)
     return false;
 }
 
+/**
+ * Uses the arrays of an aligned map file in place from a read only memory mapping.
+ *
+ * The pages are shared with every other process mapping the same file and stay in the OS file cache
+ * across restarts. Returns false only if the file can't be mapped at all, m_mapping stays NULL if the
+ * mapped data is broken.
+ */
+bool GridMap::mapData(char const* filename, GridMapFileHeader const& header)
+{
+    try
+    {
+        m_mapping = new GridMapFileMapping(filename);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        sLog.outError("Map file '%s' can't be memory mapped (%s), loading it to memory.", filename, e.what());
+        return false;
+    }
+
+    char const* error = NULL;
+    if (header.areaMapOffset && !mapAreaData(header.areaMapOffset))
+        error = "area";
+    else if (header.heightMapOffset && !mapHeightData(header.heightMapOffset))
+        error = "height";
+    else if (header.liquidMapOffset && !mapGridMapLiquidData(header.liquidMapOffset))
+        error = "liquids";
+
+    if (error)
+    {
+        sLog.outError("Error loading map %s data\n", error);
+        unloadData();
+    }
+
+    return true;
+}
+
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    // mapped arrays are released with the mapping
+    if (m_mapping)
+    {
+        delete m_mapping;
+        m_mapping = NULL;
+    }
+    else
+    {
+        delete[] m_area_map;
+        delete[] m_V9;
+        delete[] m_V8;
+        delete[] m_liquidEntry;
+        delete[] m_liquidFlags;
+        delete[] m_liquid_map;
+    }
 
     m_area_map = NULL;
     m_V9 = NULL;
@@ -145,13 +234,25 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        uint16* area_map = new uint16 [16 * 16];
+        fread(area_map, sizeof(uint16), 16 * 16, in);
+        m_area_map = area_map;
     }
 
     return true;
 }
 
+template<class T>
+static void LoadHeightArrays(FILE* in, T const*& V9, T const*& V8)
+{
+    T* data9 = new T [129 * 129];
+    T* data8 = new T [128 * 128];
+    fread(data9, sizeof(T), 129 * 129, in);
+    fread(data8, sizeof(T), 128 * 128, in);
+    V9 = data9;
+    V8 = data8;
+}
+
 bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
@@ -165,28 +266,19 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
+            LoadHeightArrays(in, m_uint16_V9, m_uint16_V8);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
+            LoadHeightArrays(in, m_uint8_V9, m_uint8_V8);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            LoadHeightArrays(in, m_V9, m_V8);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
@@ -213,17 +305,113 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
+        uint16* liquidEntry = new uint16[16 * 16];
+        fread(liquidEntry, sizeof(uint16), 16 * 16, in);
+        m_liquidEntry = liquidEntry;
 
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        uint8* liquidFlags = new uint8[16 * 16];
+        fread(liquidFlags, sizeof(uint8), 16 * 16, in);
+        m_liquidFlags = liquidFlags;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        float* liquid_map = new float [m_liquid_width * m_liquid_height];
+        fread(liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        m_liquid_map = liquid_map;
+    }
+
+    return true;
+}
+
+bool GridMap::mapAreaData(uint32 offset)
+{
+    GridMapAreaHeader const* header = GetMappedArray<GridMapAreaHeader>(m_mapping, offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+        return false;
+
+    m_gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
+    {
+        m_area_map = GetMappedArray<uint16>(m_mapping, offset + sizeof(GridMapAreaHeader), 16 * 16);
+        if (!m_area_map)
+            return false;
+    }
+
+    return true;
+}
+
+template<class T>
+static bool MapHeightArrays(GridMapFileMapping const* mapping, uint32 offset, T const*& V9, T const*& V8)
+{
+    V9 = GetMappedArray<T>(mapping, offset, 129 * 129);
+    V8 = GetMappedArray<T>(mapping, offset + 129 * 129 * sizeof(T), 128 * 128);
+    return V9 && V8;
+}
+
+bool GridMap::mapHeightData(uint32 offset)
+{
+    GridMapHeightHeader const* header = GetMappedArray<GridMapHeightHeader>(m_mapping, offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+        return false;
+
+    m_gridHeight = header->gridHeight;
+    if (header->flags & MAP_HEIGHT_NO_HEIGHT)
+        return true;
+
+    offset += sizeof(GridMapHeightHeader);
+    if ((header->flags & MAP_HEIGHT_AS_INT16))
+    {
+        if (!MapHeightArrays(m_mapping, offset, m_uint16_V9, m_uint16_V8))
+            return false;
+        m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
+        m_gridGetHeight = &GridMap::getHeightFromUint16;
+    }
+    else if ((header->flags & MAP_HEIGHT_AS_INT8))
+    {
+        if (!MapHeightArrays(m_mapping, offset, m_uint8_V9, m_uint8_V8))
+            return false;
+        m_gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
+        m_gridGetHeight = &GridMap::getHeightFromUint8;
+    }
+    else
+    {
+        if (!MapHeightArrays(m_mapping, offset, m_V9, m_V8))
+            return false;
+        m_gridGetHeight = &GridMap::getHeightFromFloat;
+    }
+
+    return true;
+}
+
+bool GridMap::mapGridMapLiquidData(uint32 offset)
+{
+    GridMapLiquidHeader const* header = GetMappedArray<GridMapLiquidHeader>(m_mapping, offset, 1);
+    if (!header || header->fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+        return false;
+
+    m_liquidType    = header->liquidType;
+    m_liquid_offX   = header->offsetX;
+    m_liquid_offY   = header->offsetY;
+    m_liquid_width  = header->width;
+    m_liquid_height = header->height;
+    m_liquidLevel   = header->liquidLevel;
+
+    offset += sizeof(GridMapLiquidHeader);
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
+    {
+        m_liquidEntry = GetMappedArray<uint16>(m_mapping, offset, 16 * 16);
+        m_liquidFlags = GetMappedArray<uint8>(m_mapping, offset + 16 * 16 * sizeof(uint16), 16 * 16);
+        if (!m_liquidEntry || !m_liquidFlags)
+            return false;
+        offset += 16 * 16 * (sizeof(uint16) + sizeof(uint8));
+    }
+
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
+    {
+        m_liquid_map = GetMappedArray<float>(m_mapping, offset, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
+            return false;
     }
 
     return true;
@@ -344,7 +532,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -412,7 +600,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -615,7 +803,7 @@ bool GridMap::ExistMap(uint32 mapid, int gx, int gy)
     GridMapFileHeader header;
     fread(&header, sizeof(header), 1, pf);
     if (header.mapMagic     != *((uint32 const*)(MAP_MAGIC)) ||
-            header.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)) ||
+            !IsAcceptableMapVersion(header.versionMagic) ||
             !IsAcceptableClientBuild(header.buildMagic))
     {
         sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", tmp);
@@ -657,6 +845,8 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
             m_GridMaps[i][k] = NULL;
+            m_PrefetchedMaps[i][k] = NULL;
+            m_PrefetchTimes[i][k] = 0;
             m_GridRef[i][k] = 0;
         }
     }
@@ -673,8 +863,13 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
 TerrainInfo::~TerrainInfo()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
+    {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
+        {
             delete m_GridMaps[i][k];
+            delete m_PrefetchedMaps[i][k];
+        }
+    }
 
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
@@ -719,6 +914,9 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    const uint32 now = WorldTimer::getMSTime();
+    const uint32 prefetchUnloadDelay = sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN);
+
     for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
@@ -740,6 +938,17 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
                 // unload mmap...
                 MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
             }
+
+            // prefetched for a grid nobody entered, kept as long as an unused loaded grid
+            if (m_PrefetchedMaps[x][y] && iRef == 0)
+            {
+                LOCK_GUARD lock(m_mutex);
+                if (WorldTimer::getMSTimeDiff(m_PrefetchTimes[x][y], now) >= prefetchUnloadDelay)
+                {
+                    delete m_PrefetchedMaps[x][y];
+                    m_PrefetchedMaps[x][y] = NULL;
+                }
+            }
         }
     }
 
@@ -770,6 +979,28 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 }
 
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    float height;
+    GetHeightStatic(&x, &y, &z, &height, 1, useVmaps, maxSearchDist);
+    return height;
+}
+
+void TerrainInfo::GetHeightStatic(float const* x, float const* y, float const* z, float* heights, uint32 count, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // resolve the vmap manager once for the whole batch
+    VMAP::IVMapManager* vmgr = NULL;
+    if (useVmaps)
+    {
+        vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+        if (!vmgr->isHeightCalcEnabled())
+            vmgr = NULL;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = CalculateHeightStatic(vmgr, x[i], y[i], z[i], maxSearchDist);
+}
+
+float TerrainInfo::CalculateHeightStatic(VMAP::IVMapManager* vmgr, float x, float y, float z, float maxSearchDist) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
@@ -780,28 +1011,24 @@ float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=tr
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
         mapHeight = gmap->getHeight(x, y);
 
-    if (useVmaps)
+    if (vmgr)
     {
-        VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-        if (vmgr->isHeightCalcEnabled())
-        {
-            // if mapHeight has been found search vmap height at least until mapHeight point
-            // this prevent case when original Z "too high above ground and vmap height search fail"
-            // this will not affect most normal cases (no map in instance, or stay at ground at continent)
-            if (mapHeight > INVALID_HEIGHT && z2 - mapHeight > maxSearchDist)
-                maxSearchDist = z2 - mapHeight + 1.0f;      // 1.0 make sure that we not fail for case when map height near but above for vamp height
-
-            // look from a bit higher pos to find the floor
-            vmapHeight = vmgr->getHeight(GetMapId(), x, y, z2, maxSearchDist);
-
-            // if not found in expected range, look for infinity range (case of far above floor, but below terrain-height)
-            if (vmapHeight <= INVALID_HEIGHT)
-                vmapHeight = vmgr->getHeight(GetMapId(), x, y, z2, 10000.0f);
-
-            // still not found, look near terrain height
-            if (vmapHeight <= INVALID_HEIGHT && mapHeight > INVALID_HEIGHT && z2 < mapHeight)
-                vmapHeight = vmgr->getHeight(GetMapId(), x, y, mapHeight + 2.0f, DEFAULT_HEIGHT_SEARCH);
-        }
+        // if mapHeight has been found search vmap height at least until mapHeight point
+        // this prevent case when original Z "too high above ground and vmap height search fail"
+        // this will not affect most normal cases (no map in instance, or stay at ground at continent)
+        if (mapHeight > INVALID_HEIGHT && z2 - mapHeight > maxSearchDist)
+            maxSearchDist = z2 - mapHeight + 1.0f;          // 1.0 make sure that we not fail for case when map height near but above for vamp height
+
+        // look from a bit higher pos to find the floor
+        vmapHeight = vmgr->getHeight(GetMapId(), x, y, z2, maxSearchDist);
+
+        // if not found in expected range, look for infinity range (case of far above floor, but below terrain-height)
+        if (vmapHeight <= INVALID_HEIGHT)
+            vmapHeight = vmgr->getHeight(GetMapId(), x, y, z2, 10000.0f);
+
+        // still not found, look near terrain height
+        if (vmapHeight <= INVALID_HEIGHT && mapHeight > INVALID_HEIGHT && z2 < mapHeight)
+            vmapHeight = vmgr->getHeight(GetMapId(), x, y, mapHeight + 2.0f, DEFAULT_HEIGHT_SEARCH);
     }
 
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
@@ -1116,21 +1343,13 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
-
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: \n %s\n", tmp);
-                // ASSERT(false);
-            }
+            // the map file may already be read by the prefetch thread
+            GridMap* map = m_PrefetchedMaps[x][y];
+            if (map)
+                m_PrefetchedMaps[x][y] = NULL;
+            else
+                map = LoadGridMapFile(x, y);
 
-            delete[] tmp;
             m_GridMaps[x][y] = map;
 
             // load VMAPs for current map/grid...
@@ -1159,6 +1378,78 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
     return  m_GridMaps[x][y];
 }
 
+GridMap* TerrainInfo::LoadGridMapFile(const uint32 x, const uint32 y) const
+{
+    GridMap* map = new GridMap();
+
+    // map file name
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+    if (!map->loadData(tmp))
+    {
+        sLog.outError("Error load map file: \n %s\n", tmp);
+        // ASSERT(false);
+    }
+
+    delete[] tmp;
+    return map;
+}
+
+// reads a file once, so loading it right after is served from the OS file cache
+static void ReadFileAhead(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer)) {}
+
+    fclose(file);
+}
+
+void TerrainInfo::Prefetch(const uint32 x, const uint32 y)
+{
+    if (IsLoadedOrPrefetched(x, y))
+        return;
+
+    char tileName[32];
+
+    // aligned map files are only mapped, read them so the first height queries don't wait for the disk
+    snprintf(tileName, sizeof(tileName), "%03u%02u%02u.map", m_mapId, x, y);
+    ReadFileAhead(sWorld.GetDataPath() + "maps/" + tileName);
+
+    // the height map is loaded here, vmap and mmap tiles are only read since their managers are used by the map threads
+    GridMap* map = LoadGridMapFile(x, y);
+
+    if (VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+    {
+        // same name as StaticMapTree::getTileFileName
+        snprintf(tileName, sizeof(tileName), "%03u_%02u_%02u.vmtile", m_mapId, y, x);
+        ReadFileAhead(sWorld.GetDataPath() + "vmaps/" + tileName);
+    }
+
+    if (MMAP::MMapFactory::IsPathfindingEnabled(m_mapId))
+    {
+        snprintf(tileName, sizeof(tileName), "%03u%02u%02u.mmtile", m_mapId, x, y);
+        ReadFileAhead(sWorld.GetDataPath() + "mmaps/" + tileName);
+    }
+
+    LOCK_GUARD lock(m_mutex);
+
+    // loaded by the map thread meanwhile
+    if (IsLoadedOrPrefetched(x, y))
+        delete map;
+    else
+    {
+        m_PrefetchedMaps[x][y] = map;
+        m_PrefetchTimes[x][y] = WorldTimer::getMSTime();
+    }
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= NULL*/) const
 {
     if (const_cast<TerrainInfo*>(this)->GetGrid(x, y))
@@ -1186,12 +1477,14 @@ float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= N
 INSTANTIATE_SINGLETON_2(TerrainManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(TerrainManager, boost::mutex);
 
-TerrainManager::TerrainManager()
+TerrainManager::TerrainManager() : m_prefetchThread(NULL), m_prefetchStop(false)
 {
 }
 
 TerrainManager::~TerrainManager()
 {
+    StopPrefetch();
+
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
         delete it->second;
 }
@@ -1235,6 +1528,17 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
 
 void TerrainManager::Update(const uint32 diff)
 {
+    // terrains referenced by done prefetch requests, a map unloaded meanwhile left them to us
+    std::vector<TerrainInfo*> prefetchedTerrains;
+    {
+        boost::lock_guard<boost::mutex> guard(m_prefetchLock);
+        prefetchedTerrains.swap(m_prefetchedTerrains);
+    }
+
+    for (std::vector<TerrainInfo*>::const_iterator itr = prefetchedTerrains.begin(); itr != prefetchedTerrains.end(); ++itr)
+        if ((*itr)->Release())
+            UnloadTerrain((*itr)->GetMapId());
+
     // global garbage collection for GridMap objects and VMaps
     for (TerrainDataMap::iterator iter = i_TerrainMap.begin(); iter != i_TerrainMap.end(); ++iter)
         iter->second->CleanUpGrids(diff);
@@ -1242,12 +1546,93 @@ void TerrainManager::Update(const uint32 diff)
 
 void TerrainManager::UnloadAll()
 {
+    StopPrefetch();
+
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
         delete it->second;
 
     i_TerrainMap.clear();
 }
 
+void TerrainManager::PrefetchGrid(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    if (terrain->IsLoadedOrPrefetched(x, y))
+        return;
+
+    PrefetchRequest request(terrain, x, y);
+
+    {
+        boost::lock_guard<boost::mutex> guard(m_prefetchLock);
+
+        if (m_prefetchStop)
+            return;
+
+        if (std::find(m_prefetchQueue.begin(), m_prefetchQueue.end(), request) != m_prefetchQueue.end())
+            return;
+
+        if (!m_prefetchThread)
+            m_prefetchThread = new boost::thread(boost::bind(&TerrainManager::PrefetchThread, this));
+
+        terrain->AddRef();
+        m_prefetchQueue.push_back(request);
+    }
+
+    m_prefetchCondition.notify_one();
+}
+
+void TerrainManager::PrefetchThread()
+{
+    for (;;)
+    {
+        PrefetchRequest request(NULL, 0, 0);
+
+        {
+            boost::unique_lock<boost::mutex> guard(m_prefetchLock);
+
+            while (m_prefetchQueue.empty() && !m_prefetchStop)
+                m_prefetchCondition.wait(guard);
+
+            if (m_prefetchStop)
+                break;
+
+            request = m_prefetchQueue.front();
+        }
+
+        request.m_terrain->Prefetch(request.m_x, request.m_y);
+
+        // dequeue only now, a request for the same grid queued meanwhile is dropped as duplicate.
+        // The terrain is released by Update(), it may be the last reference and is unloaded there
+        boost::lock_guard<boost::mutex> guard(m_prefetchLock);
+        m_prefetchQueue.pop_front();
+        m_prefetchedTerrains.push_back(request.m_terrain);
+    }
+}
+
+void TerrainManager::StopPrefetch()
+{
+    {
+        boost::lock_guard<boost::mutex> guard(m_prefetchLock);
+        m_prefetchStop = true;
+    }
+    m_prefetchCondition.notify_all();
+
+    if (m_prefetchThread)
+    {
+        m_prefetchThread->join();
+        delete m_prefetchThread;
+        m_prefetchThread = NULL;
+    }
+
+    // only called at shutdown, the terrains are deleted right after
+    for (std::deque<PrefetchRequest>::const_iterator itr = m_prefetchQueue.begin(); itr != m_prefetchQueue.end(); ++itr)
+        itr->m_terrain->Release();
+    m_prefetchQueue.clear();
+
+    for (std::vector<TerrainInfo*>::const_iterator itr = m_prefetchedTerrains.begin(); itr != m_prefetchedTerrains.end(); ++itr)
+        (*itr)->Release();
+    m_prefetchedTerrains.clear();
+}
+
 uint32 TerrainManager::GetAreaIdByAreaFlag(uint16 areaflag, uint32 map_id)
 {
     AreaTableEntry const* entry = GetAreaEntryByAreaFlagAndMap(areaflag, map_id);
@@ -29,8 +29,11 @@
 #include <boost/atomic.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/lock_guard.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <bitset>
+#include <deque>
 #include <list>
 
 class Creature;
@@ -40,6 +43,12 @@ class InstanceData;
 class Group;
 class BattleGround;
 class Map;
+struct GridMapFileMapping;
+
+namespace VMAP
+{
+    class IVMapManager;
+}
 
 struct GridMapFileHeader
 {
@@ -126,24 +135,27 @@ class GridMap
 
         uint32 m_flags;
 
+        // set if the arrays are used in place from the file, see mapData()
+        GridMapFileMapping* m_mapping;
+
         // Area data
         uint16 m_gridArea;
-        uint16* m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -153,14 +165,19 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry;
-        uint8* m_liquidFlags;
-        float* m_liquid_map;
+        uint16 const* m_liquidEntry;
+        uint8 const* m_liquidFlags;
+        float const* m_liquid_map;
 
         bool loadAreaData(FILE* in, uint32 offset, uint32 size);
         bool loadHeightData(FILE* in, uint32 offset, uint32 size);
         bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
 
+        bool mapData(char const* filename, GridMapFileHeader const& header);
+        bool mapAreaData(uint32 offset);
+        bool mapHeightData(uint32 offset);
+        bool mapGridMapLiquidData(uint32 offset);
+
         // Get height functions and pointers
         typedef float(GridMap::*pGetHeightPtr)(float x, float y) const;
         pGetHeightPtr m_gridGetHeight;
@@ -223,6 +240,8 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<boost::atomic_long>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // batched form, heights[i] is the height at x[i], y[i], z[i]
+        void GetHeightStatic(float const* x, float const* y, float const* z, float* heights, uint32 count, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = NULL) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = NULL, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = 0) const;
@@ -246,6 +265,10 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<boost::atomic_long>
         // THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
         void CleanUpGrids(const uint32 diff);
 
+        // reads the terrain files of a grid ahead of Load(), called by the TerrainManager prefetch thread
+        void Prefetch(const uint32 x, const uint32 y);
+        bool IsLoadedOrPrefetched(const uint32 x, const uint32 y) const { return m_GridMaps[x][y] || m_PrefetchedMaps[x][y]; }
+
     protected:
         friend class Map;
         // load/unload terrain data
@@ -257,7 +280,10 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<boost::atomic_long>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y);
+        // vmgr is NULL if vmap heights are not wanted
+        float CalculateHeightStatic(VMAP::IVMapManager* vmgr, float x, float y, float z, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
+        GridMap* LoadGridMapFile(const uint32 x, const uint32 y) const;
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
@@ -265,6 +291,8 @@ class MANGOS_DLL_SPEC TerrainInfo : public Referencable<boost::atomic_long>
         const uint32 m_mapId;
 
         GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        GridMap* m_PrefetchedMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];   // read by Prefetch(), taken over by LoadMapAndVMap()
+        uint32 m_PrefetchTimes[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];      // when m_PrefetchedMaps were read, for CleanUpGrids()
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         // global garbage collection timer
@@ -289,6 +317,9 @@ class MANGOS_DLL_DECL TerrainManager : public MaNGOS::Singleton<TerrainManager,
         void Update(const uint32 diff);
         void UnloadAll();
 
+        // queues reading the terrain files of a grid on the prefetch thread, see Map::PrefetchGridsAhead
+        void PrefetchGrid(TerrainInfo* terrain, uint32 x, uint32 y);
+
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
             TerrainInfo* pData = const_cast<TerrainManager*>(this)->LoadTerrain(mapid);
@@ -318,8 +349,28 @@ class MANGOS_DLL_DECL TerrainManager : public MaNGOS::Singleton<TerrainManager,
         TerrainManager(const TerrainManager&);
         TerrainManager& operator=(const TerrainManager&);
 
+        void PrefetchThread();
+        void StopPrefetch();
+
         typedef MaNGOS::ClassLevelLockable<TerrainManager, boost::mutex>::Lock Guard;
         TerrainDataMap i_TerrainMap;
+
+        struct PrefetchRequest
+        {
+            PrefetchRequest(TerrainInfo* terrain, uint32 x, uint32 y) : m_terrain(terrain), m_x(x), m_y(y) {}
+
+            bool operator==(PrefetchRequest const& other) const { return m_terrain == other.m_terrain && m_x == other.m_x && m_y == other.m_y; }
+
+            TerrainInfo* m_terrain;                         ///< referenced while queued
+            uint32 m_x, m_y;
+        };
+
+        std::deque<PrefetchRequest> m_prefetchQueue;
+        std::vector<TerrainInfo*> m_prefetchedTerrains;     ///< done requests, their reference is released by Update()
+        boost::mutex m_prefetchLock;
+        boost::condition_variable m_prefetchCondition;
+        boost::thread* m_prefetchThread;                    ///< started with the first request
+        bool m_prefetchStop;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
@@ -46,19 +46,22 @@ void VisibleNotifier::Notify()
     {
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetObjectGuid()) != i_clientGUIDs.end())
+            if (!i_clientGUIDs.IsVisited((*itr)->GetObjectGuid()))
             {
                 // ignore far sight case
                 (*itr)->UpdateVisibilityOf(*itr, &player);
                 player.UpdateVisibilityOf(&player, *itr, i_data, i_visibleNow);
-                i_clientGUIDs.erase((*itr)->GetObjectGuid());
+                i_clientGUIDs.MarkVisited((*itr)->GetObjectGuid());
             }
         }
     }
 
     // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    GuidSet notVisited;
+    i_clientGUIDs.GetNotVisited(notVisited);
+
+    i_data.AddOutOfRangeGUID(notVisited);
+    for (GuidSet::iterator itr = notVisited.begin(); itr != notVisited.end(); ++itr)
     {
         player.m_clientGUIDs.erase(*itr);
 
@@ -108,7 +111,7 @@ void MessageDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
@@ -123,7 +126,7 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = owner->GetSession())
-            session->SendPacket(i_message);
+            i_message.SendTo(session);
     }
 }
 
@@ -135,7 +138,7 @@ void ObjectMessageDeliverer::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-            session->SendPacket(i_message);
+            i_message.SendTo(session);
     }
 }
 
@@ -153,7 +156,7 @@ void MessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
@@ -168,7 +171,7 @@ void ObjectMessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(session);
         }
     }
 }
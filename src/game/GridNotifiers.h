@@ -36,10 +36,10 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        ClientGuidSet& i_clientGUIDs;
         std::set<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) { i_clientGUIDs.BeginSweep(); }
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
@@ -57,7 +57,7 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        BroadcastPacket i_message;
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
@@ -67,7 +67,7 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket*  i_message;
+        BroadcastPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket* msg, Player const* skipped)
@@ -80,7 +80,7 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket* i_message;
+        BroadcastPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket* msg)
             : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
         void Visit(CameraMapType& m);
@@ -90,7 +90,7 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        BroadcastPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -104,7 +104,7 @@ namespace MaNGOS
     struct MANGOS_DLL_DECL ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket* i_message;
+        BroadcastPacket i_message;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
@@ -140,6 +140,17 @@ namespace MaNGOS
 #endif
     };
 
+    // collects alive players and creatures for the batched relocation notifications, see Map::ProcessRelocationNotifies
+    struct MANGOS_DLL_DECL RelocationNotifyCollector
+    {
+        std::vector<Player*>& i_players;
+        std::vector<Creature*>& i_creatures;
+        RelocationNotifyCollector(std::vector<Player*>& players, std::vector<Creature*>& creatures) : i_players(players), i_creatures(creatures) {}
+        template<class T> void Visit(GridRefManager<T>&) {}
+        void Visit(PlayerMapType&);
+        void Visit(CreatureMapType&);
+    };
+
     struct MANGOS_DLL_DECL DynamicObjectUpdater
     {
         DynamicObject& i_dynobject;
@@ -35,7 +35,7 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        i_clientGUIDs.MarkVisited(iter->getSource()->GetObjectGuid());
     }
 }
 
@@ -114,6 +114,26 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType& m)
     }
 }
 
+inline void MaNGOS::RelocationNotifyCollector::Visit(PlayerMapType& m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* player = iter->getSource();
+        if (player->isAlive() && !player->IsTaxiFlying())
+            i_players.push_back(player);
+    }
+}
+
+inline void MaNGOS::RelocationNotifyCollector::Visit(CreatureMapType& m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Creature* c = iter->getSource();
+        if (c->isAlive())
+            i_creatures.push_back(c);
+    }
+}
+
 inline void MaNGOS::DynamicObjectUpdater::VisitHelper(Unit* target)
 {
     if (!target->isAlive() || target->IsTaxiFlying())
@@ -132,6 +132,9 @@ bool Group::Create(ObjectGuid guid, const char* name)
     {
         m_Id = sObjectMgr.GenerateGroupLowGuid();
 
+        // the rows of a group are written in order on the async connection of the group
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
         Player* leader = sObjectMgr.GetPlayer(guid);
         if (leader)
         {
@@ -225,6 +228,8 @@ bool Group::LoadMemberFromDB(uint32 guidLow, uint8 subgroup, bool assistant)
 
 void Group::ConvertToRaid()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     m_groupType = GroupType(m_groupType | GROUPTYPE_RAID);
 
     _initRaidSubGroupsCounter();
@@ -413,6 +418,8 @@ void Group::ChangeLeader(ObjectGuid guid)
 
 void Group::Disband(bool hideDestroy)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     Player* player;
 
     for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr)
@@ -1093,6 +1100,7 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore)
 {
+    ::BroadcastPacket broadcast(packet);
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -1100,7 +1108,7 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            broadcast.SendTo(pl->GetSession());
     }
 }
 
@@ -1155,6 +1163,8 @@ bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant)
 
 bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant, uint8 group)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (IsFull())
         return false;
 
@@ -1219,6 +1229,8 @@ bool Group::_addMember(ObjectGuid guid, const char* name, bool isAssistant, uint
 
 bool Group::_removeMember(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     Player* player = sObjectMgr.GetPlayer(guid);
     if (player)
     {
@@ -1260,6 +1272,9 @@ bool Group::_removeMember(ObjectGuid guid)
 
 void Group::_setLeader(ObjectGuid guid)
 {
+    // the instance binds are written on the default async connection, see Player::BindToInstance
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id, 0);
+
     member_citerator slot = _getMemberCSlot(guid);
     if (slot == m_memberSlots.end())
         return;
@@ -1350,6 +1365,8 @@ void Group::_removeRolls(ObjectGuid guid)
 
 bool Group::_setMembersGroup(ObjectGuid guid, uint8 group)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     member_witerator slot = _getMemberWSlot(guid);
     if (slot == m_memberSlots.end())
         return false;
@@ -1366,6 +1383,8 @@ bool Group::_setMembersGroup(ObjectGuid guid, uint8 group)
 
 bool Group::_setAssistantFlag(ObjectGuid guid, const bool& state)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     member_witerator slot = _getMemberWSlot(guid);
     if (slot == m_memberSlots.end())
         return false;
@@ -1378,6 +1397,8 @@ bool Group::_setAssistantFlag(ObjectGuid guid, const bool& state)
 
 bool Group::_setMainTank(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (m_mainTankGuid == guid)
         return false;
 
@@ -1401,6 +1422,8 @@ bool Group::_setMainTank(ObjectGuid guid)
 
 bool Group::_setMainAssistant(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (m_mainAssistantGuid == guid)
         return false;
 
@@ -1636,6 +1659,8 @@ GroupJoinBattlegroundResult Group::CanJoinBattleGroundQueue(BattleGround const*
 
 void Group::SetDungeonDifficulty(Difficulty difficulty)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     m_dungeonDifficulty = difficulty;
     if (!isBGGroup())
         CharacterDatabase.PExecute("UPDATE groups SET difficulty = %u WHERE groupId='%u'", m_dungeonDifficulty, m_Id);
@@ -1652,6 +1677,8 @@ void Group::SetDungeonDifficulty(Difficulty difficulty)
 
 void Group::SetRaidDifficulty(Difficulty difficulty)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     m_raidDifficulty = difficulty;
     if (!isBGGroup())
         CharacterDatabase.PExecute("UPDATE groups SET raiddifficulty = %u WHERE groupId='%u'", m_raidDifficulty, m_Id);
@@ -1691,6 +1718,8 @@ bool Group::SetPlayerMap(ObjectGuid guid, uint32 mapid)
 
 void Group::ResetInstances(InstanceResetMethod method, bool isRaid, Player* SendMsgTo)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     if (isBGGroup())
         return;
 
@@ -1806,6 +1835,8 @@ InstanceGroupBind* Group::GetBoundInstance(Map* aMap, Difficulty difficulty)
 
 InstanceGroupBind* Group::BindToInstance(DungeonPersistentState* state, bool permanent, bool load)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     if (state && !isBGGroup())
     {
         InstanceGroupBind& bind = m_boundInstances[state->GetDifficulty()][state->GetMapId()];
@@ -1841,6 +1872,8 @@ InstanceGroupBind* Group::BindToInstance(DungeonPersistentState* state, bool per
 
 void Group::UnbindInstance(uint32 mapid, uint8 difficulty, bool unload)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     BoundInstancesMap::iterator itr = m_boundInstances[difficulty].find(mapid);
     if (itr != m_boundInstances[difficulty].end())
     {
@@ -47,6 +47,8 @@ void MemberSlot::UpdateLogoutTime()
 
 void MemberSlot::SetPNOTE(std::string pnote)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, guildId);
+
     Pnote = pnote;
 
     // pnote now can be used for encoding to DB
@@ -56,6 +58,8 @@ void MemberSlot::SetPNOTE(std::string pnote)
 
 void MemberSlot::SetOFFNOTE(std::string offnote)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, guildId);
+
     OFFnote = offnote;
 
     // offnote now can be used for encoding to DB
@@ -65,6 +69,8 @@ void MemberSlot::SetOFFNOTE(std::string offnote)
 
 void MemberSlot::ChangeRank(uint32 newRank)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, guildId);
+
     RankId = newRank;
 
     Player* player = sObjectMgr.GetPlayer(guid);
@@ -121,6 +127,9 @@ bool Guild::Create(Player* leader, std::string gname)
     m_Id = sObjectMgr.GenerateGuildId();
     m_CreatedDate = time(0);
 
+    // the rows of a guild are written in order on the async connection of the guild
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     DEBUG_LOG("GUILD: creating guild %s to leader: %s", gname.c_str(), m_LeaderGuid.GetString().c_str());
 
     // gname already assigned to Guild::name, use it to encode string for DB
@@ -146,6 +155,8 @@ bool Guild::Create(Player* leader, std::string gname)
 
 void Guild::CreateDefaultGuildRanks(int locale_idx)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     CharacterDatabase.PExecute("DELETE FROM guild_rank WHERE guildid='%u'", m_Id);
     CharacterDatabase.PExecute("DELETE FROM guild_bank_right WHERE guildid = '%u'", m_Id);
 
@@ -160,6 +171,8 @@ void Guild::CreateDefaultGuildRanks(int locale_idx)
 
 bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     Player* pl = sObjectMgr.GetPlayer(plGuid);
     if (pl)
     {
@@ -214,6 +227,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         }
     }
 
+    newmember.guildId = m_Id;
     newmember.RankId  = plRank;
     newmember.OFFnote = (std::string)"";
     newmember.Pnote   = (std::string)"";
@@ -246,6 +260,8 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 
 void Guild::SetMOTD(std::string motd)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     MOTD = motd;
 
     // motd now can be used for encoding to DB
@@ -255,6 +271,8 @@ void Guild::SetMOTD(std::string motd)
 
 void Guild::SetGINFO(std::string ginfo)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     GINFO = ginfo;
 
     // ginfo now can be used for encoding to DB
@@ -422,6 +440,7 @@ bool Guild::LoadMembersFromDB(QueryResult* guildMembersResult)
         MemberSlot newmember;
         uint32 lowguid = fields[1].GetUInt32();
         newmember.guid = ObjectGuid(HIGHGUID_PLAYER, lowguid);
+        newmember.guildId = m_Id;
         newmember.RankId = fields[2].GetUInt32();
         // don't allow member to have not existing rank!
         if (newmember.RankId >= m_Ranks.size())
@@ -479,6 +498,8 @@ bool Guild::LoadMembersFromDB(QueryResult* guildMembersResult)
 
 void Guild::SetLeader(ObjectGuid guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     MemberSlot* slot = GetMemberSlot(guid);
     if (!slot)
         return;
@@ -499,6 +520,8 @@ void Guild::SetLeader(ObjectGuid guid)
  */
 bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     uint32 lowguid = guid.GetCounter();
 
     // guild master can be deleted when loading guild and guid doesn't exist in characters table
@@ -594,23 +617,25 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
+    ::BroadcastPacket broadcast(packet);
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
         if (player)
-            player->GetSession()->SendPacket(packet);
+            broadcast.SendTo(player->GetSession());
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
+    ::BroadcastPacket broadcast(packet);
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         if (itr->second.RankId == rankId)
         {
             Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
             if (player)
-                player->GetSession()->SendPacket(packet);
+                broadcast.SendTo(player->GetSession());
         }
     }
 }
@@ -650,6 +675,8 @@ void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 max
 
 void Guild::CreateRank(std::string name_, uint32 rights)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (m_Ranks.size() >= GUILD_RANKS_MAX_COUNT)
         return;
 
@@ -677,6 +704,8 @@ void Guild::AddRank(const std::string& name_, uint32 rights, uint32 money)
 
 void Guild::DelRank()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     // client won't allow to have less than GUILD_RANKS_MIN_COUNT ranks in guild
     if (m_Ranks.size() <= GUILD_RANKS_MIN_COUNT)
         return;
@@ -707,6 +736,8 @@ uint32 Guild::GetRankRights(uint32 rankId)
 
 void Guild::SetRankName(uint32 rankId, std::string name_)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (rankId >= m_Ranks.size())
         return;
 
@@ -719,6 +750,8 @@ void Guild::SetRankName(uint32 rankId, std::string name_)
 
 void Guild::SetRankRights(uint32 rankId, uint32 rights)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (rankId >= m_Ranks.size())
         return;
 
@@ -734,6 +767,8 @@ void Guild::SetRankRights(uint32 rankId, uint32 rights)
  */
 void Guild::Disband()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     BroadcastEvent(GE_DISBANDED);
 
     while (!members.empty())
@@ -842,6 +877,8 @@ void Guild::Query(WorldSession* session)
 
 void Guild::SetEmblem(uint32 emblemStyle, uint32 emblemColor, uint32 borderStyle, uint32 borderColor, uint32 backgroundColor)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     m_EmblemStyle = emblemStyle;
     m_EmblemColor = emblemColor;
     m_BorderStyle = borderStyle;
@@ -940,6 +977,8 @@ void Guild::LoadGuildEventLogFromDB()
 // Add entry to guild eventlog
 void Guild::LogGuildEvent(uint8 EventType, ObjectGuid playerGuid1, ObjectGuid playerGuid2, uint8 newRank)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     GuildEventLogEntry NewEvent;
     // Create event
     NewEvent.EventType = EventType;
@@ -1119,6 +1158,8 @@ void Guild::DisplayGuildBankTabsInfo(WorldSession* session)
 
 void Guild::CreateNewBankTab()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (GetPurchasedTabs() >= GUILD_BANK_MAX_TABS)
         return;
 
@@ -1133,6 +1174,8 @@ void Guild::CreateNewBankTab()
 
 void Guild::SetGuildBankTabInfo(uint8 TabId, std::string Name, std::string Icon)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (m_TabListMap[TabId]->Name == Name && m_TabListMap[TabId]->Icon == Icon)
         return;
 
@@ -1158,6 +1201,8 @@ uint32 Guild::GetBankRights(uint32 rankId, uint8 TabId) const
 // This load should be called on startup only
 void Guild::LoadGuildBankFromDB()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     //                                                     0      1        2        3
     QueryResult* result = CharacterDatabase.PQuery("SELECT TabId, TabName, TabIcon, TabText FROM guild_bank_tab WHERE guildid='%u' ORDER BY TabId", m_Id);
     if (!result)
@@ -1252,6 +1297,8 @@ void Guild::SendMoneyInfo(WorldSession* session, uint32 LowGuid)
 
 bool Guild::MemberMoneyWithdraw(uint32 amount, uint32 LowGuid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     uint32 MoneyWithDrawRight = GetMemberMoneyWithdrawRem(LowGuid);
 
     if (MoneyWithDrawRight < amount || GetGuildBankMoney() < amount)
@@ -1273,6 +1320,8 @@ bool Guild::MemberMoneyWithdraw(uint32 amount, uint32 LowGuid)
 
 void Guild::SetBankMoney(int64 money)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (money < 0)                                          // I don't know how this happens, it does!!
         money = 0;
     m_GuildBankMoney = money;
@@ -1285,6 +1334,8 @@ void Guild::SetBankMoney(int64 money)
 
 bool Guild::MemberItemWithdraw(uint8 TabId, uint32 LowGuid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     uint32 SlotsWithDrawRight = GetMemberSlotWithdrawRem(LowGuid, TabId);
 
     if (SlotsWithDrawRight == 0)
@@ -1316,6 +1367,8 @@ bool Guild::IsMemberHaveRights(uint32 LowGuid, uint8 TabId, uint32 rights) const
 
 uint32 Guild::GetMemberSlotWithdrawRem(uint32 LowGuid, uint8 TabId)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     MemberList::iterator itr = members.find(LowGuid);
     if (itr == members.end())
         return 0;
@@ -1339,6 +1392,8 @@ uint32 Guild::GetMemberSlotWithdrawRem(uint32 LowGuid, uint8 TabId)
 
 uint32 Guild::GetMemberMoneyWithdrawRem(uint32 LowGuid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     MemberList::iterator itr = members.find(LowGuid);
     if (itr == members.end())
         return 0;
@@ -1360,6 +1415,8 @@ uint32 Guild::GetMemberMoneyWithdrawRem(uint32 LowGuid)
 
 void Guild::SetBankMoneyPerDay(uint32 rankId, uint32 money)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (rankId >= m_Ranks.size())
         return;
 
@@ -1378,6 +1435,8 @@ void Guild::SetBankMoneyPerDay(uint32 rankId, uint32 money)
 
 void Guild::SetBankRightsAndSlots(uint32 rankId, uint8 TabId, uint32 right, uint32 nbSlots, bool db)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (rankId >= m_Ranks.size() || TabId >= GetPurchasedTabs())
     {
         // TODO remove next line, It is there just to repair existing bug in deleting guild rank
@@ -1471,6 +1530,8 @@ bool Guild::LoadBankRightsFromDB(QueryResult* guildBankTabRightsResult)
 
 void Guild::LoadGuildBankEventLogFromDB()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     // Money log is in TabId = GUILD_BANK_MONEY_LOGS_TAB
 
     // uint32 configCount = sWorld.getConfig(CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT);
@@ -1625,6 +1686,8 @@ void Guild::DisplayGuildBankLogs(WorldSession* session, uint8 TabId)
 
 void Guild::LogBankEvent(uint8 EventType, uint8 TabId, uint32 PlayerGuidLow, uint32 ItemOrMoney, uint8 ItemStackCount, uint8 DestTabId)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     // create Event
     GuildBankEventLogEntry NewEvent;
     NewEvent.EventType = EventType;
@@ -1666,6 +1729,8 @@ void Guild::LogBankEvent(uint8 EventType, uint8 TabId, uint32 PlayerGuidLow, uin
 
 bool Guild::AddGBankItemToDB(uint32 GuildId, uint32 BankTab , uint32 BankTabSlot , uint32 GUIDLow, uint32 Entry)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GuildId);
+
     CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE guildid = '%u' AND TabId = '%u'AND SlotId = '%u'", GuildId, BankTab, BankTabSlot);
     CharacterDatabase.PExecute("INSERT INTO guild_bank_item (guildid,TabId,SlotId,item_guid,item_entry) "
                                "VALUES ('%u', '%u', '%u', '%u', '%u')", GuildId, BankTab, BankTabSlot, GUIDLow, Entry);
@@ -1737,6 +1802,8 @@ Item* Guild::StoreItem(uint8 tabId, GuildItemPosCountVec const& dest, Item* pIte
 // Return stored item (if stored to stack, it can diff. from pItem). And pItem ca be deleted in this case.
 Item* Guild::_StoreItem(uint8 tab, uint8 slot, Item* pItem, uint32 count, bool clone)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (!pItem)
         return NULL;
 
@@ -1783,6 +1850,8 @@ Item* Guild::_StoreItem(uint8 tab, uint8 slot, Item* pItem, uint32 count, bool c
 
 void Guild::RemoveItem(uint8 tab, uint8 slot)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     m_TabListMap[tab]->Slots[slot] = NULL;
     CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE guildid='%u' AND TabId='%u' AND SlotId='%u'",
                                GetId(), uint32(tab), uint32(slot));
@@ -1935,6 +2004,8 @@ InventoryResult Guild::CanStoreItem(uint8 tab, uint8 slot, GuildItemPosCountVec&
 
 void Guild::SetGuildBankTabText(uint8 TabId, std::string text)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     if (TabId >= GetPurchasedTabs())
         return;
 
@@ -1971,6 +2042,8 @@ void Guild::SendGuildBankTabText(WorldSession* session, uint8 TabId)
 
 void Guild::SwapItems(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankTabDst, uint8 BankTabSlotDst, uint32 SplitedAmount)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     // empty operation
     if (BankTab == BankTabDst && BankTabSlot == BankTabSlotDst)
         return;
@@ -2095,6 +2168,9 @@ void Guild::SwapItems(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankTa
 
 void Guild::MoveFromBankToChar(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 PlayerBag, uint8 PlayerSlot, uint32 SplitedAmount)
 {
+    // items change hands between the guild and the account of the player
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id, pl->GetSession()->GetAccountId());
+
     Item* pItemBank = GetItem(BankTab, BankTabSlot);
     Item* pItemChar = pl->GetItemByPos(PlayerBag, PlayerSlot);
 
@@ -2243,6 +2319,9 @@ void Guild::MoveFromBankToChar(Player* pl, uint8 BankTab, uint8 BankTabSlot, uin
 
 void Guild::MoveFromCharToBank(Player* pl, uint8 PlayerBag, uint8 PlayerSlot, uint8 BankTab, uint8 BankTabSlot, uint32 SplitedAmount)
 {
+    // items change hands between the guild and the account of the player
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id, pl->GetSession()->GetAccountId());
+
     Item* pItemBank = GetItem(BankTab, BankTabSlot);
     Item* pItemChar = pl->GetItemByPos(PlayerBag, PlayerSlot);
 
@@ -2422,6 +2501,8 @@ void Guild::BroadcastEvent(GuildEvents event, ObjectGuid guid, char const* str1
 
 void Guild::DeleteGuildBankItems(bool alsoInDB /*= false*/)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, m_Id);
+
     for (size_t i = 0; i < m_TabListMap.size(); ++i)
     {
         for (uint8 j = 0; j < GUILD_BANK_MAX_SLOTS; ++j)
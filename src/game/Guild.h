@@ -260,6 +260,7 @@ struct MemberSlot
     void ChangeRank(uint32 newRank);
 
     ObjectGuid guid;
+    uint32 guildId;                                         // key of the async DB requests, see Guild::Create
     uint32 accountId;
     std::string Name;
     uint32 RankId;
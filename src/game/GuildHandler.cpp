@@ -899,6 +899,8 @@ void WorldSession::HandleGuildBankDepositMoney(WorldPacket& recv_data)
     if (!pGuild->GetPurchasedTabs())
         return;
 
+    // money changes hands between the guild and the account
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GuildId, GetAccountId());
     CharacterDatabase.BeginTransaction();
 
     pGuild->SetBankMoney(pGuild->GetGuildBankMoney() + money);
@@ -953,6 +955,8 @@ void WorldSession::HandleGuildBankWithdrawMoney(WorldPacket& recv_data)
     if (!pGuild->HasRankRight(GetPlayer()->GetRank(), GR_RIGHT_WITHDRAW_GOLD))
         return;
 
+    // money changes hands between the guild and the account
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GuildId, GetAccountId());
     CharacterDatabase.BeginTransaction();
 
     if (!pGuild->MemberMoneyWithdraw(money, GetPlayer()->GetGUIDLow()))
@@ -3947,6 +3947,9 @@ bool ChatHandler::HandleCharacterRenameCommand(char* args)
     if (!ExtractPlayerTarget(&args, &target, &target_guid, &target_name))
         return false;
 
+    // the character row is written in order with the requests of its account
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(target_guid));
+
     if (target)
     {
         // check online security
@@ -3981,6 +3984,8 @@ bool ChatHandler::HandleCharacterCustomizeCommand(char* args)
     if (!ExtractPlayerTarget(&args, &target, &target_guid, &target_name))
         return false;
 
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(target_guid));
+
     if (target)
     {
         PSendSysMessage(LANG_CUSTOMIZE_PLAYER, GetNameLink(target).c_str());
@@ -5377,8 +5382,9 @@ bool ChatHandler::HandleMmapLocCommand(char* /*args*/)
     PSendSysMessage("gridloc [%i,%i]", gx, gy);
 
     // calculate navmesh tile location
-    const dtNavMesh* navmesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(player->GetMapId());
-    const dtNavMeshQuery* navmeshquery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(player->GetMapId(), player->GetInstanceId());
+    MMAP::NavMeshQueryHolder query(player->GetMapId());
+    const dtNavMesh* navmesh = query.GetNavMesh();
+    const dtNavMeshQuery* navmeshquery = query.GetQuery();
     if (!navmesh || !navmeshquery)
     {
         PSendSysMessage("NavMesh not loaded for current map.");
@@ -5422,8 +5428,9 @@ bool ChatHandler::HandleMmapLoadedTilesCommand(char* /*args*/)
 {
     uint32 mapid = m_session->GetPlayer()->GetMapId();
 
-    const dtNavMesh* navmesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(mapid);
-    const dtNavMeshQuery* navmeshquery = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQuery(mapid, m_session->GetPlayer()->GetInstanceId());
+    MMAP::NavMeshQueryHolder query(mapid);
+    const dtNavMesh* navmesh = query.GetNavMesh();
+    const dtNavMeshQuery* navmeshquery = query.GetQuery();
     if (!navmesh || !navmeshquery)
     {
         PSendSysMessage("NavMesh not loaded for current map.");
@@ -5490,3 +5497,31 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
 
     return true;
 }
+
+bool ChatHandler::HandleMmapPathCacheCommand(char* args)
+{
+    PathCache& cache = m_session->GetPlayer()->GetMap()->GetPathCache();
+
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        cache.ResetStats();
+        PSendSysMessage("Path cache stats of current map reset.");
+        return true;
+    }
+
+    if (!cache.GetCapacity())
+    {
+        PSendSysMessage("Path cache disabled for current map.");
+        return true;
+    }
+
+    PathCache::Stats stats = cache.GetStats();
+    uint32 lookups = stats.m_hits + stats.m_misses;
+
+    PSendSysMessage("Path cache stats on current map:");
+    PSendSysMessage(" %u of %u paths cached", stats.m_size, cache.GetCapacity());
+    PSendSysMessage(" %u hits, %u misses (%.1f%% hit rate)", stats.m_hits, stats.m_misses, lookups ? stats.m_hits * 100.0f / lookups : 0.0f);
+    PSendSysMessage(" %u paths dropped by navmesh or collision changes", stats.m_invalidations);
+
+    return true;
+}
@@ -57,6 +57,7 @@
 #include "DBCEnums.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
 #include "SQLStorages.h"
+#include "WorldSocketMgr.h"
 
 static uint32 ahbotQualityIds[MAX_AUCTION_QUALITY] =
 {
@@ -4428,6 +4429,8 @@ void ChatHandler::HandleCharacterLevel(Player* player, ObjectGuid player_guid, u
     else
     {
         // update level and XP at level, all other will be updated at loading
+        // in order with the requests of the account of the character
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(player_guid));
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, player_guid.GetCounter());
     }
 }
@@ -5082,6 +5085,7 @@ bool ChatHandler::HandleResetSpellsCommand(char* args)
     }
     else
     {
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(target_guid));
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", uint32(AT_LOGIN_RESET_SPELLS), target_guid.GetCounter());
         PSendSysMessage(LANG_RESET_SPELLS_OFFLINE, target_name.c_str());
     }
@@ -5115,6 +5119,7 @@ bool ChatHandler::HandleResetSpecsCommand(char* args)
     else if (target_guid)
     {
         uint32 at_flags = AT_LOGIN_RESET_TALENTS | AT_LOGIN_RESET_PET_TALENTS;
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(target_guid));
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", at_flags, target_guid.GetCounter());
         std::string nameLink = playerLink(target_name);
         PSendSysMessage(LANG_RESET_TALENTS_OFFLINE, nameLink.c_str());
@@ -6262,6 +6267,82 @@ bool ChatHandler::HandleServerPLimitCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleServerMapStatsCommand(char* /*args*/)
+{
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+
+    PSendSysMessage("Map update times (last/avg/max ms) for %u maps:", uint32(maps.size()));
+
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map const* map = itr->second;
+        PSendSysMessage("Map %u instance %u (%s): players %u, update %u/%u/%u",
+                        map->GetId(), map->GetInstanceId(), map->GetMapName(), uint32(map->GetPlayers().getSize()),
+                        map->GetLastUpdateTime(), map->GetAverageUpdateTime(), map->GetMaxUpdateTime());
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerNetStatsCommand(char* /*args*/)
+{
+    PSendSysMessage("Outgoing queue: %li extra buffers chained, %li connections closed at queue limit",
+                    sWorldSocketMgr.GetOutgoingOverflowBuffers(), sWorldSocketMgr.GetOutgoingOverflowDisconnects());
+
+    // opcodes whose packets most often outgrew the storage reserved when they were created
+    std::vector<std::pair<uint32, uint16> > outgrown;
+    for (uint16 id = 0; id < NUM_MSG_TYPES; ++id)
+        if (uint32 count = opcodeSizeStats[id].outgrown)
+            outgrown.push_back(std::pair<uint32, uint16>(count, id));
+
+    if (outgrown.empty())
+        return true;
+
+    std::sort(outgrown.begin(), outgrown.end(), std::greater<std::pair<uint32, uint16> >());
+    if (outgrown.size() > 10)
+        outgrown.resize(10);
+
+    SendSysMessage("Packets outgrowing their reserved storage (outgrown/sent, avg/max size):");
+
+    for (std::vector<std::pair<uint32, uint16> >::const_iterator itr = outgrown.begin(); itr != outgrown.end(); ++itr)
+    {
+        OpcodeSizeStats const& stats = opcodeSizeStats[itr->second];
+        uint32 sent = stats.sent;
+        PSendSysMessage("%s: %u/%u, %u/%u bytes", LookupOpcodeName(itr->second), itr->first, sent,
+                        sent ? uint32(stats.totalSize / sent) : 0, uint32(stats.maxSize));
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerDBStatsCommand(char* /*args*/)
+{
+    struct
+    {
+        const char* name;
+        Database* db;
+    } databases[] =
+    {
+        { "World",     &WorldDatabase },
+        { "Character", &CharacterDatabase },
+        { "Login",     &LoginDatabase }
+    };
+
+    for (size_t i = 0; i < countof(databases); ++i)
+    {
+        SqlDelayThread::Stats stats;
+        if (!databases[i].db->GetDelayThreadStats(stats))
+            continue;
+
+        PSendSysMessage("%s DB async queue (%u connections): %u waiting (peak %u), " UI64FMTD " executed, " UI64FMTD " in " UI64FMTD " batches, " UI64FMTD " batches replayed",
+                        databases[i].name, uint32(databases[i].db->GetAsyncConnectionCount()), uint32(stats.queueSize), uint32(stats.queuePeak), stats.executed, stats.batchedRequests, stats.batches, stats.failedBatches);
+        PSendSysMessage("  latency <1ms: " UI64FMTD ", <5ms: " UI64FMTD ", <10ms: " UI64FMTD ", <50ms: " UI64FMTD ", <100ms: " UI64FMTD ", <500ms: " UI64FMTD ", slower: " UI64FMTD,
+                        stats.latency[0], stats.latency[1], stats.latency[2], stats.latency[3], stats.latency[4], stats.latency[5], stats.latency[6]);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(char* args)
 {
     if (!*args)
@@ -0,0 +1,166 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LoadingStage.h"
+#include "Database/DatabaseEnv.h"
+#include "ProgressBar.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+uint32 LoadingStage::Add(char const* description, Loader const& loader)
+{
+    m_tasks.push_back(Task(description, loader));
+    return uint32(m_tasks.size() - 1);
+}
+
+uint32 LoadingStage::Add(char const* description, Loader const& loader, uint32 after)
+{
+    uint32 id = Add(description, loader);
+    AddDependency(id, after);
+    return id;
+}
+
+uint32 LoadingStage::Add(char const* description, Loader const& loader, uint32 after1, uint32 after2)
+{
+    uint32 id = Add(description, loader);
+    AddDependency(id, after1);
+    AddDependency(id, after2);
+    return id;
+}
+
+uint32 LoadingStage::Add(char const* description, Loader const& loader, uint32 after1, uint32 after2, uint32 after3)
+{
+    uint32 id = Add(description, loader, after1, after2);
+    AddDependency(id, after3);
+    return id;
+}
+
+void LoadingStage::AddDependency(uint32 id, uint32 after)
+{
+    // only earlier loaders can be named, so the dependencies can't form a cycle
+    MANGOS_ASSERT(after < id);
+
+    m_tasks[after].m_dependents.push_back(id);
+    ++m_tasks[id].m_pendingDependencies;
+}
+
+void LoadingStage::Run(uint32 threads)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    if (threads <= 1 || m_tasks.size() <= 1)
+    {
+        // insertion order already respects the dependencies
+        for (uint32 id = 0; id < m_tasks.size(); ++id)
+            RunTask(id);
+    }
+    else
+    {
+        for (uint32 id = 0; id < m_tasks.size(); ++id)
+            if (!m_tasks[id].m_pendingDependencies)
+                m_ready.push_back(id);
+
+        m_remaining = m_tasks.size();
+
+        // progress bars of concurrent loaders would overwrite each other
+        bool showBars = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        boost::thread_group workers;
+        for (uint32 i = 0; i < threads && i < m_tasks.size(); ++i)
+            workers.create_thread(boost::bind(&LoadingStage::WorkerThread, this));
+
+        workers.join_all();
+
+        BarGoLink::SetOutputState(showBars);
+    }
+
+    m_wallTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    PrintReport();
+}
+
+void LoadingStage::RunTask(uint32 id)
+{
+    Task& task = m_tasks[id];
+
+    sLog.outString("Loading %s...", task.m_description);
+
+    uint32 startTime = WorldTimer::getMSTime();
+    task.m_loader();
+    task.m_time = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void LoadingStage::WorkerThread()
+{
+    // loaders query the world database, some also the character database
+    WorldDatabase.ThreadStart();
+
+    for (;;)
+    {
+        uint32 id;
+
+        {
+            boost::unique_lock<boost::mutex> guard(m_lock);
+
+            while (m_ready.empty() && m_remaining > 0)
+                m_condition.wait(guard);
+
+            if (m_ready.empty())
+                break;                                      // everything loaded
+
+            id = m_ready.front();
+            m_ready.pop_front();
+        }
+
+        RunTask(id);
+
+        {
+            boost::lock_guard<boost::mutex> guard(m_lock);
+
+            --m_remaining;
+
+            std::vector<uint32> const& dependents = m_tasks[id].m_dependents;
+            for (std::vector<uint32>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+                if (--m_tasks[*itr].m_pendingDependencies == 0)
+                    m_ready.push_back(*itr);
+        }
+
+        m_condition.notify_all();
+    }
+
+    WorldDatabase.ThreadEnd();
+}
+
+void LoadingStage::PrintReport() const
+{
+    uint32 loaderTime = 0;
+    for (std::vector<Task>::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        loaderTime += itr->m_time;
+
+    sLog.outString();
+    sLog.outString(">> Stage %s: " SIZEFMTD " loaders in %u ms (%u ms spent in loaders)", m_name, m_tasks.size(), m_wallTime, loaderTime);
+
+    for (std::vector<Task>::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        sLog.outString("   %7u ms  %s", itr->m_time, itr->m_description);
+
+    sLog.outString();
+}
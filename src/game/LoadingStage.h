@@ -0,0 +1,89 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_LOADINGSTAGE_H
+#define MANGOS_LOADINGSTAGE_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
+#include <vector>
+
+/**
+ * A group of startup loaders run by World::SetInitialWorldSettings, optionally on several threads.
+ *
+ * Loaders are added in the order they would run one by one and may name earlier loaders of the
+ * same stage they depend on, a loader is only started after all of its dependencies finished.
+ * With one thread the loaders run in the order they were added, like the plain calls they replace.
+ * Loaders of a stage must only fill their own containers, anything else they touch has to be
+ * loaded before the stage starts.
+ */
+class MANGOS_DLL_DECL LoadingStage
+{
+    public:
+        typedef boost::function<void()> Loader;
+
+        explicit LoadingStage(char const* name) : m_name(name), m_remaining(0), m_wallTime(0) {}
+
+        // returns the id to use as dependency of loaders added later
+        uint32 Add(char const* description, Loader const& loader);
+        uint32 Add(char const* description, Loader const& loader, uint32 after);
+        uint32 Add(char const* description, Loader const& loader, uint32 after1, uint32 after2);
+        uint32 Add(char const* description, Loader const& loader, uint32 after1, uint32 after2, uint32 after3);
+
+        // runs all loaders and prints the timing report of the stage
+        void Run(uint32 threads);
+
+    private:
+        LoadingStage(const LoadingStage&);
+        LoadingStage& operator=(const LoadingStage&);
+
+        struct Task
+        {
+            Task(char const* description, Loader const& loader) :
+                m_description(description), m_loader(loader), m_pendingDependencies(0), m_time(0) {}
+
+            char const* m_description;
+            Loader m_loader;
+            std::vector<uint32> m_dependents;               ///< loaders waiting for this one
+            uint32 m_pendingDependencies;
+            uint32 m_time;                                  ///< ms spent in the loader
+        };
+
+        void AddDependency(uint32 id, uint32 after);
+        void RunTask(uint32 id);
+        void WorkerThread();
+        void PrintReport() const;
+
+        char const* m_name;
+        std::vector<Task> m_tasks;
+
+        boost::mutex m_lock;
+        boost::condition_variable m_condition;              ///< signalled when loaders become ready or all are done
+        std::deque<uint32> m_ready;
+        size_t m_remaining;                                 ///< loaders not finished yet
+
+        uint32 m_wallTime;
+};
+
+#endif
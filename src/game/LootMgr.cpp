@@ -100,12 +100,20 @@ void LootStore::LoadLootTable()
 
     sLog.outString("%s :", GetName());
 
-    //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    // the rows are streamed, so the row count for the progress bar is queried separately
+    uint32 rowCount = 0;
+    if (QueryResult* countResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", GetName()))
+    {
+        rowCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                       0      1     2                    3        4              5         6
+    QueryResult* result = WorldDatabase.PQueryStream("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
 
     if (result)
     {
-        BarGoLink bar(result->GetRowCount());
+        BarGoLink bar(rowCount);
 
         do
         {
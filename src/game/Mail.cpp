@@ -211,6 +211,9 @@ void MailDraft::SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, Ob
         return;
     }
 
+    // the items change hands between the account of the caller and the one of the receiver
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, receiver ? receiver->GetSession()->GetAccountId() : rc_account, CharacterDatabase.GetAsyncKey());
+
     // prepare mail and send in other case
     bool needItemDelay = false;
 
@@ -259,6 +262,10 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         return;
     }
 
+    // the mail belongs to the receiver's account, kept in order with the requests of the caller too,
+    // e.g. the items taken from the sender or the auction removed
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, pReceiver ? pReceiver->GetSession()->GetAccountId() : pReceiverAccount, CharacterDatabase.GetAsyncKey());
+
     bool has_items = !m_items.empty();
 
     // generate mail template items for online player, for offline player items will generated at open
@@ -276,6 +276,9 @@ void WorldSession::HandleSendMail(WorldPacket& recv_data)
 
     bool needItemDelay = false;
 
+    // items and money change hands between both accounts
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GetAccountId(), rc_account);
+
     MailDraft draft(subject, body);
 
     if (items_count > 0 || money > 0)
@@ -35,10 +35,12 @@
 #include "DBCEnums.h"
 #include "MapPersistentStateMgr.h"
 #include "VMapFactory.h"
-#include "MoveMap.h"
+#include "vmap/GameObjectModel.h"
+#include "PathFinder.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "Calendar.h"
 #include "Chat.h"
+#include "PoolManager.h"
 
 Map::~Map()
 {
@@ -53,8 +55,13 @@ Map::~Map()
     delete i_data;
     i_data = NULL;
 
-    // unload instance specific navigation data
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(m_TerrainData->GetMapId(), GetInstanceId());
+    // requests of units that left the map without cancelling them
+    for (std::vector<PathFinder*>::const_iterator itr = m_pathRequests.begin(); itr != m_pathRequests.end(); ++itr)
+        (*itr)->requestFinished();
+
+    // objects still linked, e.g. items of players that left the map, must not point to the list anymore
+    while (LinkedListElement* link = i_objectsToClientUpdate.getFirst())
+        link->delink();
 
     // release reference count
     if (m_TerrainData->Release())
@@ -76,7 +83,9 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL), i_script_id(0)
+      i_data(NULL), i_script_id(0), m_pathCache(sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE)),
+      m_concurrentCellUpdate(false),
+      m_lastUpdateTime(0), m_maxUpdateTime(0), m_totalUpdateTime(0), m_updateCount(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -203,6 +212,8 @@ void Map::DeleteFromWorld(Player* pl)
 void
 Map::EnsureGridCreated(const GridPair& p)
 {
+    SharedStateGuard guard(*this);
+
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         setNGrid(new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
@@ -252,6 +263,8 @@ Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
 
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
+    SharedStateGuard guard(*this);
+
     EnsureGridCreated(GridPair(cell.GridX(), cell.GridY()));
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -322,6 +335,8 @@ Map::Add(T* obj)
 
     obj->SetMap(this);
 
+    SharedStateGuard guard(*this);
+
     Cell cell(p);
     if (obj->isActiveObject())
         EnsureGridLoadedAtEnter(cell);
@@ -471,6 +486,10 @@ void Map::Update(const uint32& t_diff)
     // for pets
     TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
+    // with a cell updater the marked cells are only collected here and updated below
+    MapCellUpdater* cellUpdater = sMapMgr.GetCellUpdater(GetId());
+    std::vector<uint32> cellsToUpdate;
+
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -493,11 +512,16 @@ void Map::Update(const uint32& t_diff)
                 if (!isCellMarked(cell_id))
                 {
                     markCell(cell_id);
-                    CellPair pair(x, y);
-                    Cell cell(pair);
-                    cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
+                    if (cellUpdater)
+                        cellsToUpdate.push_back(cell_id);
+                    else
+                    {
+                        CellPair pair(x, y);
+                        Cell cell(pair);
+                        cell.SetNoCreate();
+                        Visit(cell, grid_object_update);
+                        Visit(cell, world_object_update);
+                    }
                 }
             }
         }
@@ -531,17 +555,31 @@ void Map::Update(const uint32& t_diff)
                     if (!isCellMarked(cell_id))
                     {
                         markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
+                        if (cellUpdater)
+                            cellsToUpdate.push_back(cell_id);
+                        else
+                        {
+                            CellPair pair(x, y);
+                            Cell cell(pair);
+                            cell.SetNoCreate();
+                            Visit(cell, grid_object_update);
+                            Visit(cell, world_object_update);
+                        }
                     }
                 }
             }
         }
     }
 
+    if (!cellsToUpdate.empty())
+        UpdateCellsConcurrently(cellsToUpdate, t_diff, *cellUpdater);
+
+    // AI reactions to the movement done in this and earlier updates
+    ProcessRelocationNotifies();
+
+    // paths requested in this update, picked up by the movement generators in the next one
+    ProcessPathRequests();
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -572,6 +610,8 @@ void Map::Remove(Player* player, bool remove)
     if (i_data)
         i_data->OnPlayerLeave(player);
 
+    BuildPathRequestsOf(player);
+
     if (remove)
         player->CleanupsBeforeDelete();
     else
@@ -630,6 +670,10 @@ Map::Remove(T* obj, bool remove)
         return;
     }
 
+    SharedStateGuard guard(*this);
+
+    BuildPathRequestsOf(obj);
+
     Cell cell(p);
     if (!loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
         return;
@@ -673,6 +717,8 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     Cell new_cell(new_val);
     bool same_cell = (new_cell == old_cell);
 
+    PrefetchGridsAhead(player, x, y);
+
     player->Relocate(x, y, z, orientation);
 
     if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
@@ -700,12 +746,65 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
     }
 }
 
+/**
+ * Extrapolates the movement of the player and lets the terrain of grids it is heading for be read
+ * in the background, so crossing into them doesn't wait for the map, vmap and mmap files.
+ */
+void Map::PrefetchGridsAhead(Player* player, float x, float y)
+{
+    uint32 lookAhead = sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_TIME);
+    if (!lookAhead)
+        return;
+
+    float dx = x - player->GetPositionX();
+    float dy = y - player->GetPositionY();
+    float dist = sqrt(dx * dx + dy * dy);
+    if (dist < 0.1f)
+        return;
+
+    // fast enough for flying and mounted players, taxi flights are covered by the look ahead time
+    float speed = std::max(player->GetSpeed(MOVE_RUN), player->GetSpeed(MOVE_FLIGHT));
+    float range = speed * lookAhead / IN_MILLISECONDS;
+
+    GridPair current = MaNGOS::ComputeGridPair(x, y);
+    GridPair last = current;
+
+    // half a grid steps don't skip over a grid corner
+    for (float step = SIZE_OF_GRIDS / 2; step < range + SIZE_OF_GRIDS / 2; step += SIZE_OF_GRIDS / 2)
+    {
+        float predictedX = x + dx / dist * std::min(step, range);
+        float predictedY = y + dy / dist * std::min(step, range);
+        if (!MaNGOS::IsValidMapCoord(predictedX, predictedY))
+            break;
+
+        GridPair p = MaNGOS::ComputeGridPair(predictedX, predictedY);
+        if (p == last)
+            continue;
+        last = p;
+
+        // z code, as in EnsureGridCreated
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+
+        if (!m_bLoadedGrids[gx][gy])
+            sTerrainMgr.PrefetchGrid(m_TerrainData, gx, gy);
+    }
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
 {
     MANGOS_ASSERT(CheckGridIntegrity(creature, false));
 
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    // the new cell can belong to a region updated by another thread, move there after the phase
+    if (m_concurrentCellUpdate && new_cell != creature->GetCurrentCell())
+    {
+        SharedStateGuard guard(*this);
+        m_deferredRelocations.push_back(DeferredRelocation(creature, x, y, z, ang));
+        return;
+    }
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature, new_cell))
     {
@@ -877,6 +976,177 @@ const char* Map::GetMapName() const
     return i_mapEntry ? i_mapEntry->name[sWorld.GetDefaultDbcLocale()] : "UNNAMEDMAP\x0";
 }
 
+void Map::UpdateCells(std::vector<uint32> const& cellIds, uint32 diff)
+{
+    MaNGOS::ObjectUpdater updater(diff);
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    for (std::vector<uint32>::const_iterator itr = cellIds.begin(); itr != cellIds.end(); ++itr)
+    {
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+}
+
+/**
+ * Updates the marked cells of the map on the cell updater threads.
+ *
+ * The cells are grouped into square regions of whole grids, wider than twice the visibility distance.
+ * Regions are updated in four phases by the parity of their coordinates, so two regions of the same
+ * phase always have a full region between them and objects updated at the same time can't see or
+ * reach a common object. Map wide containers are locked during a phase, creature moves into another
+ * cell, additions to the remove list, pool updates, instance data and zone script hooks, creature
+ * linking events and kill rewards are collected and applied after it.
+ */
+void Map::UpdateCellsConcurrently(std::vector<uint32> const& cellIds, uint32 diff, MapCellUpdater& updater)
+{
+    uint32 regionGrids = uint32(2 * GetVisibilityDistance() / SIZE_OF_GRIDS) + 1;
+    uint32 regionCells = regionGrids * MAX_NUMBER_OF_CELLS;
+
+    typedef std::map<uint32, std::vector<uint32> > RegionMap;
+    RegionMap phases[4];
+
+    for (std::vector<uint32>::const_iterator itr = cellIds.begin(); itr != cellIds.end(); ++itr)
+    {
+        uint32 regionX = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / regionCells;
+        uint32 regionY = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / regionCells;
+        phases[(regionX & 1) | ((regionY & 1) << 1)][regionY * TOTAL_NUMBER_OF_CELLS_PER_MAP + regionX].push_back(*itr);
+    }
+
+    std::vector<MapCellUpdater::CellIdList> regions;
+    for (int phase = 0; phase < 4; ++phase)
+    {
+        if (phases[phase].empty())
+            continue;
+
+        // nothing to run side by side
+        if (phases[phase].size() == 1)
+        {
+            UpdateCells(phases[phase].begin()->second, diff);
+            continue;
+        }
+
+        regions.clear();
+        for (RegionMap::iterator itr = phases[phase].begin(); itr != phases[phase].end(); ++itr)
+        {
+            regions.push_back(MapCellUpdater::CellIdList());
+            regions.back().swap(itr->second);
+        }
+
+        m_concurrentCellUpdate = true;
+        updater.UpdateRegions(*this, regions, diff);
+        m_concurrentCellUpdate = false;
+
+        ApplyDeferredCellChanges();
+    }
+}
+
+void Map::ApplyDeferredCellChanges()
+{
+    std::vector<DeferredRelocation> relocations;
+    relocations.swap(m_deferredRelocations);
+
+    for (std::vector<DeferredRelocation>::const_iterator itr = relocations.begin(); itr != relocations.end(); ++itr)
+        if (itr->m_creature->IsInWorld())
+            CreatureRelocation(itr->m_creature, itr->m_x, itr->m_y, itr->m_z, itr->m_orientation);
+
+    // objects are looked up again, the ones gone from the map in the meantime miss their hooks
+    std::vector<DeferredHook> hooks;
+    hooks.swap(m_deferredHooks);
+
+    for (std::vector<DeferredHook>::const_iterator itr = hooks.begin(); itr != hooks.end(); ++itr)
+    {
+        switch (itr->m_type)
+        {
+            case DeferredHook::HOOK_CREATE:
+                if (Creature* creature = GetAnyTypeCreature(itr->m_object))
+                    creature->InformCreateHooks();
+                else if (GameObject* gameobject = GetGameObject(itr->m_object))
+                    gameobject->InformCreateHooks();
+                break;
+            case DeferredHook::HOOK_DEATH:
+            {
+                Creature* victim = GetAnyTypeCreature(itr->m_object);
+                Unit* killer = GetUnit(itr->m_unit);
+                if (victim && killer)
+                    killer->InformCreatureDeathHooks(victim, itr->m_player ? ObjectAccessor::FindPlayer(itr->m_player) : NULL);
+                break;
+            }
+            case DeferredHook::HOOK_PVP_DEATH:
+            {
+                Player* victim = GetPlayer(itr->m_object);
+                Player* killer = ObjectAccessor::FindPlayer(itr->m_player);
+                if (victim && killer)
+                    victim->InformPvPDeathHooks(killer, itr->m_value != 0);
+                break;
+            }
+            // only queued by maps with instance data
+            case DeferredHook::HOOK_PLAYER_DEATH:
+                if (Player* player = GetPlayer(itr->m_object))
+                    i_data->OnPlayerDeath(player);
+                break;
+            case DeferredHook::HOOK_ENTER_COMBAT:
+                if (Creature* creature = GetAnyTypeCreature(itr->m_object))
+                    i_data->OnCreatureEnterCombat(creature);
+                break;
+            case DeferredHook::HOOK_EVADE:
+                if (Creature* creature = GetAnyTypeCreature(itr->m_object))
+                    i_data->OnCreatureEvade(creature);
+                break;
+            case DeferredHook::HOOK_CREATURE_LINKING_EVENT:
+                if (Creature* source = GetAnyTypeCreature(itr->m_object))
+                    m_creatureLinkingHolder.DoCreatureLinkingEvent(CreatureLinkingEvent(itr->m_value), source, itr->m_unit ? GetUnit(itr->m_unit) : NULL);
+                break;
+            case DeferredHook::HOOK_KILL_REWARD:
+            {
+                Unit* victim = GetUnit(itr->m_object);
+                if (!victim)
+                    break;
+
+                Player* playerTap = itr->m_player ? ObjectAccessor::FindPlayer(itr->m_player) : NULL;
+                if (Group* groupTap = itr->m_value ? sObjectMgr.GetGroupById(itr->m_value) : NULL)
+                    groupTap->RewardGroupAtKill(victim, playerTap);
+                else if (playerTap)
+                    playerTap->RewardSinglePlayerAtKill(victim);
+                break;
+            }
+        }
+    }
+
+    std::vector<WorldObject*> removes;
+    removes.swap(m_deferredRemoves);
+
+    for (std::vector<WorldObject*>::const_iterator itr = removes.begin(); itr != removes.end(); ++itr)
+        AddObjectToRemoveList(*itr);
+
+    std::vector<Creature*> corpses;
+    corpses.swap(m_deferredCorpseRemovals);
+
+    for (std::vector<Creature*>::const_iterator itr = corpses.begin(); itr != corpses.end(); ++itr)
+        if ((*itr)->IsInWorld())
+            (*itr)->RemoveCorpse();
+
+    std::vector<std::pair<uint16, uint32> > poolUpdates;
+    poolUpdates.swap(m_deferredGameObjectPoolUpdates);
+
+    for (std::vector<std::pair<uint16, uint32> >::const_iterator itr = poolUpdates.begin(); itr != poolUpdates.end(); ++itr)
+        sPoolMgr.UpdatePool<GameObject>(*GetPersistentState(), itr->first, itr->second);
+}
+
+void Map::UpdateTimeStats(uint32 updateTime)
+{
+    m_lastUpdateTime = updateTime;
+    if (updateTime > m_maxUpdateTime)
+        m_maxUpdateTime = updateTime;
+
+    m_totalUpdateTime += updateTime;
+    ++m_updateCount;
+}
+
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair)
 {
     cell.SetNoCreate();
@@ -981,12 +1251,113 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    // cleanups reach linked objects anywhere on the map, done after the phase
+    if (m_concurrentCellUpdate)
+    {
+        SharedStateGuard guard(*this);
+        m_deferredRemoves.push_back(obj);
+        return;
+    }
+
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
     // DEBUG_LOG("Object (GUID: %u TypeId: %u ) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
 
+bool Map::DeferPoolUpdate(Creature* creature)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredCorpseRemovals.push_back(creature);
+    return true;
+}
+
+bool Map::DeferPoolUpdate(GameObject* gameobject, uint16 poolId)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredGameObjectPoolUpdates.push_back(std::make_pair(poolId, gameobject->GetGUIDLow()));
+    return true;
+}
+
+bool Map::DeferCreateHooks(WorldObject* obj)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_CREATE, obj->GetObjectGuid(), ObjectGuid(), ObjectGuid(), 0));
+    return true;
+}
+
+bool Map::DeferDeathHooks(Unit* killer, Creature* victim, Player* responsiblePlayer)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_DEATH, victim->GetObjectGuid(), killer->GetObjectGuid(),
+                                           responsiblePlayer ? responsiblePlayer->GetObjectGuid() : ObjectGuid(), 0));
+    return true;
+}
+
+bool Map::DeferPvPDeathHooks(Player* victim, Player* killer, bool selfKill)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_PVP_DEATH, victim->GetObjectGuid(), ObjectGuid(), killer->GetObjectGuid(), uint32(selfKill)));
+    return true;
+}
+
+bool Map::DeferPlayerDeathHook(Player* player)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_PLAYER_DEATH, player->GetObjectGuid(), ObjectGuid(), ObjectGuid(), 0));
+    return true;
+}
+
+bool Map::DeferCombatHook(Creature* creature, bool evade)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(evade ? DeferredHook::HOOK_EVADE : DeferredHook::HOOK_ENTER_COMBAT, creature->GetObjectGuid(), ObjectGuid(), ObjectGuid(), 0));
+    return true;
+}
+
+bool Map::DeferCreatureLinkingEvent(CreatureLinkingEvent eventType, Creature* source, Unit* enemy)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_CREATURE_LINKING_EVENT, source->GetObjectGuid(),
+                                           enemy ? enemy->GetObjectGuid() : ObjectGuid(), ObjectGuid(), uint32(eventType)));
+    return true;
+}
+
+bool Map::DeferKillReward(Unit* victim, Player* playerTap, Group* groupTap)
+{
+    if (!m_concurrentCellUpdate)
+        return false;
+
+    SharedStateGuard guard(*this);
+    m_deferredHooks.push_back(DeferredHook(DeferredHook::HOOK_KILL_REWARD, victim->GetObjectGuid(), ObjectGuid(),
+                                           playerTap ? playerTap->GetObjectGuid() : ObjectGuid(), groupTap ? groupTap->GetId() : 0));
+    return true;
+}
+
 void Map::RemoveAllObjectsInRemoveList()
 {
     if (i_objectsToRemove.empty())
@@ -1084,6 +1455,8 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    SharedStateGuard guard(*this);
+
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
@@ -1112,6 +1485,8 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    SharedStateGuard guard(*this);
+
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -1610,6 +1985,8 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
         }
     }
 
+    SharedStateGuard guard(*this);
+
     ///- Schedule script execution for all scripts in the script map
     ScriptMap const* s2 = &(s->second);
     for (ScriptMap::const_iterator iter = s2->begin(); iter != s2->end(); ++iter)
@@ -1635,6 +2012,8 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa("Internal Activate Command used for spell", this, sourceGuid, targetGuid, ownerGuid, &script);
 
+    SharedStateGuard guard(*this);
+
     m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
 
     sScriptMgr.IncreaseScheduledScriptsCount();
@@ -1702,6 +2081,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    SharedStateGuard guard(*this);
     return m_objectsStore.find<Creature>(guid, (Creature*)NULL);
 }
 
@@ -1712,6 +2092,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    SharedStateGuard guard(*this);
     return m_objectsStore.find<Pet>(guid, (Pet*)NULL);
 }
 
@@ -1753,6 +2134,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    SharedStateGuard guard(*this);
     return m_objectsStore.find<GameObject>(guid, (GameObject*)NULL);
 }
 
@@ -1763,6 +2145,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    SharedStateGuard guard(*this);
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)NULL);
 }
 
@@ -1809,14 +2192,226 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return NULL;
 }
 
+void Map::ScheduleRelocationNotify(Unit* unit, uint32 delay)
+{
+    SharedStateGuard guard(*this);
+    m_relocationNotifies.push_back(RelocationNotifyRequest(unit->GetObjectGuid(), WorldTimer::getMSTime() + delay));
+}
+
+void Map::QueuePathRequest(PathFinder* path)
+{
+    SharedStateGuard guard(*this);
+    m_pathRequests.push_back(path);
+}
+
+void Map::CancelPathRequest(PathFinder* path)
+{
+    SharedStateGuard guard(*this);
+
+    std::vector<PathFinder*>::iterator itr = std::find(m_pathRequests.begin(), m_pathRequests.end(), path);
+    if (itr != m_pathRequests.end())
+        m_pathRequests.erase(itr);
+}
+
+/**
+ * Calculates the paths requested during the update on the path workers.
+ *
+ * At most mmap.pathRequestsPerTick paths are calculated, the others stay queued for the next update.
+ * Nothing else runs on the map meanwhile, so the requesting units and their movement generators
+ * stay as they were when the paths were requested.
+ */
+void Map::ProcessPathRequests()
+{
+    if (m_pathRequests.empty())
+        return;
+
+    size_t count = m_pathRequests.size();
+    if (uint32 limit = sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_REQUESTS_PER_TICK))
+        count = std::min<size_t>(count, limit);
+
+    std::vector<PathFinder*> paths(m_pathRequests.begin(), m_pathRequests.begin() + count);
+    m_pathRequests.erase(m_pathRequests.begin(), m_pathRequests.begin() + count);
+
+    if (MapPathUpdater* updater = sMapMgr.GetPathUpdater())
+        updater->CalculatePaths(paths);
+    else
+    {
+        // the pool was stopped after the paths were requested
+        for (std::vector<PathFinder*>::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+            (*itr)->buildPath();
+    }
+
+    for (std::vector<PathFinder*>::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+        (*itr)->requestFinished();
+}
+
+/**
+ * Builds the queued paths of an object leaving the map right away, as calculate() would have.
+ *
+ * Left queued they would be calculated at the end of the update while the unit may already
+ * be updated by the map it moved to.
+ */
+void Map::BuildPathRequestsOf(WorldObject const* obj)
+{
+    SharedStateGuard guard(*this);
+
+    for (std::vector<PathFinder*>::iterator itr = m_pathRequests.begin(); itr != m_pathRequests.end();)
+    {
+        PathFinder* path = *itr;
+        if (path->getSourceUnit() != obj)
+        {
+            ++itr;
+            continue;
+        }
+
+        itr = m_pathRequests.erase(itr);
+        path->buildPath();
+        path->requestFinished();
+    }
+}
+
+/**
+ * Runs the AI relocation notifications that became due since the last update.
+ *
+ * Units that moved in the same cell are handled together: the objects around them are collected
+ * with one grid visit and then matched against every unit of the cell, instead of visiting
+ * the same cells again for each of them.
+ */
+void Map::ProcessRelocationNotifies()
+{
+    if (m_relocationNotifies.empty())
+        return;
+
+    uint32 now = WorldTimer::getMSTime();
+
+    std::vector<RelocationNotifyRequest> requests;
+    requests.swap(m_relocationNotifies);
+
+    typedef std::pair<uint32, Unit*> CellUnit;
+    std::vector<CellUnit> dueUnits;
+    dueUnits.reserve(requests.size());
+
+    for (std::vector<RelocationNotifyRequest>::const_iterator itr = requests.begin(); itr != requests.end(); ++itr)
+    {
+        if (int32(now - itr->m_time) < 0)
+        {
+            m_relocationNotifies.push_back(*itr);
+            continue;
+        }
+
+        // removed from the map (or re-added and scheduled again) meanwhile
+        Unit* unit = GetUnit(itr->m_guid);
+        if (!unit || !unit->IsInWorld() || !unit->IsAINotifyScheduled())
+            continue;
+
+        CellPair p = MaNGOS::ComputeCellPair(unit->GetPositionX(), unit->GetPositionY());
+        dueUnits.push_back(CellUnit(p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord, unit));
+    }
+
+    if (dueUnits.empty())
+        return;
+
+    std::sort(dueUnits.begin(), dueUnits.end());
+
+    float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+    std::vector<Unit*> cellUnits;
+    for (std::vector<CellUnit>::const_iterator itr = dueUnits.begin(); itr != dueUnits.end();)
+    {
+        cellUnits.clear();
+
+        uint32 cellId = itr->first;
+        for (; itr != dueUnits.end() && itr->first == cellId; ++itr)
+        {
+            // the same unit can be requested twice when it was removed and added back in between
+            if (itr->second->IsAINotifyScheduled())
+            {
+                itr->second->_SetAINotifyScheduled(false);
+                cellUnits.push_back(itr->second);
+            }
+        }
+
+        if (!cellUnits.empty())
+            ProcessRelocationNotifyCell(cellUnits, radius);
+    }
+}
+
+void Map::ProcessRelocationNotifyCell(std::vector<Unit*> const& units, float radius)
+{
+    if (units.size() == 1)
+    {
+        Unit* unit = units.front();
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+        {
+            MaNGOS::PlayerRelocationNotifier notify((Player&)*unit);
+            Cell::VisitAllObjects(unit, notify, radius);
+        }
+        else
+        {
+            MaNGOS::CreatureRelocationNotifier notify((Creature&)*unit);
+            Cell::VisitAllObjects(unit, notify, radius);
+        }
+        return;
+    }
+
+    // one visit around the middle of the moved units, wide enough to cover the radius of each of them
+    float x = 0.0f, y = 0.0f;
+    for (std::vector<Unit*>::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+    {
+        x += (*itr)->GetPositionX();
+        y += (*itr)->GetPositionY();
+    }
+    x /= units.size();
+    y /= units.size();
+
+    float spread = 0.0f;
+    for (std::vector<Unit*>::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        spread = std::max(spread, (*itr)->GetDistance2d(x, y));
+
+    std::vector<Player*> players;
+    std::vector<Creature*> creatures;
+    MaNGOS::RelocationNotifyCollector collector(players, creatures);
+    Cell::VisitAllObjects(x, y, this, collector, radius + spread);
+
+    for (std::vector<Unit*>::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+    {
+        Unit* unit = *itr;
+        if (!unit->isAlive())
+            continue;
+
+        if (unit->GetTypeId() == TYPEID_PLAYER)
+        {
+            Player* player = (Player*)unit;
+            if (player->IsTaxiFlying())
+                continue;
+
+            for (std::vector<Creature*>::const_iterator c_itr = creatures.begin(); c_itr != creatures.end(); ++c_itr)
+                if ((*c_itr)->isAlive() && player->IsWithinDist(*c_itr, radius, false))
+                    PlayerCreatureRelocationWorker(player, *c_itr);
+        }
+        else
+        {
+            Creature* creature = (Creature*)unit;
+
+            for (std::vector<Player*>::const_iterator p_itr = players.begin(); p_itr != players.end(); ++p_itr)
+                if ((*p_itr)->isAlive() && !(*p_itr)->IsTaxiFlying() && creature->IsWithinDist(*p_itr, radius, false))
+                    PlayerCreatureRelocationWorker(*p_itr, creature);
+
+            for (std::vector<Creature*>::const_iterator c_itr = creatures.begin(); c_itr != creatures.end(); ++c_itr)
+                if (*c_itr != creature && (*c_itr)->isAlive() && creature->IsWithinDist(*c_itr, radius, false))
+                    CreatureCreatureRelocationWorker(*c_itr, creature);
+        }
+    }
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
-    while (!i_objectsToClientUpdate.empty())
+    while (LinkedListElement* link = i_objectsToClientUpdate.getFirst())
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
+        Object* obj = static_cast<ClientUpdateLink*>(link)->GetUpdatedObject();
+        link->delink();
         obj->BuildUpdateData(update_players);
     }
 
@@ -1831,6 +2426,8 @@ void Map::SendObjectUpdates()
 
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
 {
+    SharedStateGuard guard(*this);
+
     // TODO: for map local guid counters possible force reload map instead shutdown server at guid counter overflow
     switch (guidhigh)
     {
@@ -1953,8 +2550,22 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ))
+        return false;
+
+    DynTreeReadGuard guard(*this);
+    return m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+}
+
+void Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float const* destX, float const* destY, float const* destZ, bool* results, uint32 count, uint32 phasemask) const
+{
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, results, count);
+
+    // dynamic objects only for the targets not already blocked by static geometry
+    DynTreeReadGuard guard(*this);
+    for (uint32 i = 0; i < count; ++i)
+        if (results[i])
+            results[i] = m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX[i], destY[i], destZ[i], phasemask);
 }
 
 /**
@@ -1974,6 +2585,7 @@ bool Map::GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float
         destZ = tempZ;
     }
     // at second all dynamic objects, if static check has an hit, then we can calculate only to this closer point
+    DynTreeReadGuard guard(*this);
     bool result1 = m_dyn_tree.getObjectHitPos(phasemask, srcX, srcY, srcZ, destX, destY, destZ, tempX, tempY, tempZ, modifyDist);
     if (result1)
     {
@@ -1991,20 +2603,39 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
 
     // Get Dynamic Height around static Height (if valid)
     float dynSearchHeight = 2.0f + (z < staticHeight ? staticHeight : z);
+    DynTreeReadGuard guard(*this);
     return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight, phasemask));
 }
 
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
+    DynTreeWriteGuard guard(*this);
     m_dyn_tree.insert(mdl);
+    InvalidatePathCache(mdl);
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
+    DynTreeWriteGuard guard(*this);
     m_dyn_tree.remove(mdl);
+    InvalidatePathCache(mdl);
+}
+
+void Map::InvalidatePathCache(GameObjectModel const& mdl)
+{
+    G3D::AABox const& bounds = mdl.getBounds();
+    m_pathCache.Invalidate(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y);
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
 {
+    DynTreeReadGuard guard(*this);
     return m_dyn_tree.contains(mdl);
 }
+
+void Map::EnableGameObjectModel(GameObjectModel& mdl, uint32 phasemask)
+{
+    DynTreeWriteGuard guard(*this);
+    mdl.enable(phasemask);
+    InvalidatePathCache(mdl);
+}
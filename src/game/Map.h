@@ -35,10 +35,16 @@
 #include "TypeList.h"
 #include "ScriptMgr.h"
 #include "CreatureLinkingMgr.h"
+#include "PathCache.h"
 #include "vmap/DynamicTree.h"
 
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+
 #include <bitset>
 #include <list>
+#include <vector>
 
 struct CreatureInfo;
 class Creature;
@@ -54,6 +60,8 @@ struct ScriptInfo;
 class BattleGround;
 class GridMap;
 class GameObjectModel;
+class MapCellUpdater;
+class PathFinder;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -200,6 +208,22 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         void AddObjectToRemoveList(WorldObject* obj);
 
+        // pool updates spawn and despawn objects anywhere on the map, so they wait for the end of a concurrent cell
+        // phase. True if the corpse removal of the creature or the pool update of the gameobject was queued for it
+        bool DeferPoolUpdate(Creature* creature);
+        bool DeferPoolUpdate(GameObject* gameobject, uint16 poolId);
+
+        // instance data and zone script hooks, creature linking events and kill rewards reach objects anywhere on the map
+        // and the state shared by its scripts and groups, so they wait for the end of a concurrent cell phase as well.
+        // True if the hook was queued for it
+        bool DeferCreateHooks(WorldObject* obj);
+        bool DeferDeathHooks(Unit* killer, Creature* victim, Player* responsiblePlayer);
+        bool DeferPvPDeathHooks(Player* victim, Player* killer, bool selfKill);
+        bool DeferPlayerDeathHook(Player* player);
+        bool DeferCombatHook(Creature* creature, bool evade);
+        bool DeferCreatureLinkingEvent(CreatureLinkingEvent eventType, Creature* source, Unit* enemy);
+        bool DeferKillReward(Unit* victim, Player* playerTap, Group* groupTap);
+
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
 
         void resetMarkedCells() { marked_cells.reset(); }
@@ -246,12 +270,15 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            SharedStateGuard guard(*this);
+            if (!obj->GetClientUpdateLink().isInList())
+                i_objectsToClientUpdate.insertLast(&obj->GetClientUpdateLink());
         }
 
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            SharedStateGuard guard(*this);
+            obj->GetClientUpdateLink().delink();
         }
 
         // DynObjects currently
@@ -271,19 +298,85 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         // Dynamic VMaps
         float GetHeight(uint32 phasemask, float x, float y, float z) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        // line of sight from x1, y1, z1 to each of count targets, results[i] is set for target i
+        void IsInLineOfSight(float x1, float y1, float z1, float const* x2, float const* y2, float const* z2, bool* results, uint32 count, uint32 phasemask) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        void EnableGameObjectModel(GameObjectModel& mdl, uint32 phasemask);
 
-        // Get Holder for Creature Linking
+        // Get Holder for Creature Linking, its containers are used under a SharedStateGuard
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
 
+        /// Locks the map wide containers while cells are updated by several threads, does nothing otherwise
+        class SharedStateGuard
+        {
+            public:
+                explicit SharedStateGuard(Map& map) : m_lock(map.m_cellUpdateLock, boost::defer_lock)
+                {
+                    if (map.m_concurrentCellUpdate)
+                        m_lock.lock();
+                }
+
+            private:
+                boost::unique_lock<boost::recursive_mutex> m_lock;
+        };
+
+        // Update() timing statistics, filled by MapManager after every map update
+        void UpdateTimeStats(uint32 updateTime);
+        uint32 GetLastUpdateTime() const { return m_lastUpdateTime; }
+        uint32 GetMaxUpdateTime() const { return m_maxUpdateTime; }
+        uint32 GetAverageUpdateTime() const { return m_updateCount ? uint32(m_totalUpdateTime / m_updateCount) : 0; }
+
+        // AI relocation notification of a unit, processed in batch by Update() after delay ms, see Unit::ScheduleAINotify
+        void ScheduleRelocationNotify(Unit* unit, uint32 delay);
+
+        // paths of PathFinder::requestPath, calculated at the end of Update()
+        void QueuePathRequest(PathFinder* path);
+        void CancelPathRequest(PathFinder* path);
+
+        // poly paths found by the PathFinders of the map, dropped where the collision of the map changes
+        PathCache& GetPathCache() { return m_pathCache; }
+        void InvalidatePathCache(GameObjectModel const& mdl);
+
+        // updates the objects in the given cells, called by MapCellUpdater for one region
+        void UpdateCells(std::vector<uint32> const& cellIds, uint32 diff);
+
     private:
         void LoadMapAndVMap(int gx, int gy);
 
+        void PrefetchGridsAhead(Player* player, float x, float y);
+
+        void ProcessRelocationNotifies();
+        void ProcessRelocationNotifyCell(std::vector<Unit*> const& units, float radius);
+
+        void ProcessPathRequests();
+        void BuildPathRequestsOf(WorldObject const* obj);
+
+        void UpdateCellsConcurrently(std::vector<uint32> const& cellIds, uint32 diff, MapCellUpdater& updater);
+        void ApplyDeferredCellChanges();
+
+        /// Lets the queries of several cell threads share m_dyn_tree, gameobject model changes get it alone
+        template<class Lock>
+        class DynTreeGuard
+        {
+            public:
+                explicit DynTreeGuard(Map const& map) : m_lock(map.m_dynTreeLock, boost::defer_lock)
+                {
+                    if (map.m_concurrentCellUpdate)
+                        m_lock.lock();
+                }
+
+            private:
+                Lock m_lock;
+        };
+
+        typedef DynTreeGuard<boost::shared_lock<boost::shared_mutex> > DynTreeReadGuard;
+        typedef DynTreeGuard<boost::unique_lock<boost::shared_mutex> > DynTreeWriteGuard;
+
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
         void SendInitSelf(Player* player);
@@ -317,7 +410,7 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        LinkedListHead i_objectsToClientUpdate;             // of ClientUpdateLink, objects are linked in place without allocations
 
     protected:
         MapEntry const* i_mapEntry;
@@ -374,6 +467,67 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
+
+        struct RelocationNotifyRequest
+        {
+            RelocationNotifyRequest(ObjectGuid guid, uint32 time) : m_guid(guid), m_time(time) {}
+
+            ObjectGuid m_guid;
+            uint32 m_time;                                  ///< getMSTime() after which the notification is due
+        };
+        std::vector<RelocationNotifyRequest> m_relocationNotifies;
+
+        std::vector<PathFinder*> m_pathRequests;
+        PathCache m_pathCache;
+
+        // concurrent cell update state, see UpdateCellsConcurrently
+        struct DeferredRelocation
+        {
+            DeferredRelocation(Creature* creature, float x, float y, float z, float orientation) :
+                m_creature(creature), m_x(x), m_y(y), m_z(z), m_orientation(orientation) {}
+
+            Creature* m_creature;
+            float m_x, m_y, m_z, m_orientation;
+        };
+
+        struct DeferredHook
+        {
+            enum Type
+            {
+                HOOK_CREATE,
+                HOOK_DEATH,
+                HOOK_PVP_DEATH,
+                HOOK_PLAYER_DEATH,
+                HOOK_ENTER_COMBAT,
+                HOOK_EVADE,
+                HOOK_CREATURE_LINKING_EVENT,
+                HOOK_KILL_REWARD
+            };
+
+            DeferredHook(Type type, ObjectGuid object, ObjectGuid unit, ObjectGuid player, uint32 value) :
+                m_type(type), m_object(object), m_unit(unit), m_player(player), m_value(value) {}
+
+            Type m_type;
+            ObjectGuid m_object;                            ///< created object, victim, creature in combat or linking event source
+            ObjectGuid m_unit;                              ///< killer or linking event enemy
+            ObjectGuid m_player;                            ///< responsible or killing player, player tap
+            uint32 m_value;                                 ///< selfkill, linking event or group tap id
+        };
+
+        bool m_concurrentCellUpdate;                        ///< set while a phase of regions is updated
+        boost::recursive_mutex m_cellUpdateLock;
+        mutable boost::shared_mutex m_dynTreeLock;
+        std::vector<DeferredRelocation> m_deferredRelocations;
+        std::vector<WorldObject*> m_deferredRemoves;
+        std::vector<Creature*> m_deferredCorpseRemovals;
+        std::vector<std::pair<uint16, uint32> > m_deferredGameObjectPoolUpdates;
+        std::vector<DeferredHook> m_deferredHooks;
+
+        // Update() timing statistics
+        uint32 m_lastUpdateTime;
+        uint32 m_maxUpdateTime;
+        uint64 m_totalUpdateTime;
+        uint32 m_updateCount;
 };
 
 class MANGOS_DLL_SPEC WorldMap : public Map
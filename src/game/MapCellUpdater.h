@@ -0,0 +1,87 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPCELLUPDATER_H
+#define MANGOS_MAPCELLUPDATER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
+#include <vector>
+
+class Map;
+
+/**
+ * Worker pool used by the maps listed in MapUpdate.CellMaps to update their active cells concurrently.
+ *
+ * Map::Update splits the cells it has to update into regions that can't reach each other and hands
+ * the regions of one phase over with UpdateRegions(), which blocks until all of them are updated.
+ * Several maps can use the pool at the same time, each of them only waits for its own regions.
+ */
+class MANGOS_DLL_DECL MapCellUpdater
+{
+    public:
+        typedef std::vector<uint32> CellIdList;
+
+        MapCellUpdater();
+        ~MapCellUpdater();
+
+        void Activate(size_t numThreads);
+        void Deactivate();
+        bool IsActive() const { return m_activated; }
+        size_t GetThreadCount() const { return m_threadCount; }
+
+        void UpdateRegions(Map& map, std::vector<CellIdList> const& regions, uint32 diff);
+
+    private:
+        MapCellUpdater(const MapCellUpdater&);
+        MapCellUpdater& operator=(const MapCellUpdater&);
+
+        struct RegionUpdateRequest
+        {
+            RegionUpdateRequest(Map* map, CellIdList const* cells, uint32 diff, size_t* pending) :
+                m_map(map), m_cells(cells), m_diff(diff), m_pending(pending) {}
+
+            Map* m_map;
+            CellIdList const* m_cells;
+            uint32 m_diff;
+            size_t* m_pending;                              ///< regions of the same UpdateRegions() call not done yet
+        };
+
+        void WorkerThread();
+
+        typedef std::deque<RegionUpdateRequest> RequestQueue;
+        RequestQueue m_queue;
+
+        boost::mutex m_lock;
+        boost::condition_variable m_requestCondition;       ///< signalled when requests are queued or the pool stops
+        boost::condition_variable m_finishedCondition;      ///< signalled when the last region of a call is done
+
+        size_t m_threadCount;
+        bool m_cancelationToken;
+        bool m_activated;
+
+        boost::thread_group m_workerThreads;
+};
+
+#endif
@@ -27,6 +27,8 @@
 #include "CellImpl.h"
 #include "Corpse.h"
 #include "ObjectMgr.h"
+#include "Config.h"
+#include "Util.h"
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, boost::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
@@ -40,6 +42,10 @@ MapManager::MapManager()
 
 MapManager::~MapManager()
 {
+    m_updater.Deactivate();
+    m_cellUpdater.Deactivate();
+    m_pathUpdater.Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         delete iter->second;
 
@@ -53,6 +59,31 @@ void
 MapManager::Initialize()
 {
     InitStateMachine();
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_THREADS))
+    {
+        m_updater.Activate(numThreads);
+        sLog.outString("Using %u threads for map updates", numThreads);
+    }
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_CELL_THREADS))
+    {
+        Tokens mapIds = StrSplit(sConfig.GetStringDefault("MapUpdate.CellMaps", ""), ",");
+        for (Tokens::const_iterator itr = mapIds.begin(); itr != mapIds.end(); ++itr)
+            m_cellUpdateMaps.insert(uint32(atoi(itr->c_str())));
+
+        if (!m_cellUpdateMaps.empty())
+        {
+            m_cellUpdater.Activate(numThreads);
+            sLog.outString("Using %u threads for cell updates of " SIZEFMTD " maps", numThreads, m_cellUpdateMaps.size());
+        }
+    }
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_THREADS))
+    {
+        m_pathUpdater.Activate(numThreads);
+        sLog.outString("Using %u threads for path calculation", numThreads);
+    }
 }
 
 void MapManager::InitStateMachine()
@@ -173,8 +204,23 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
-        iter->second->Update((uint32)i_timer.GetCurrent());
+    if (m_updater.IsActive())
+    {
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+            m_updater.ScheduleUpdate(*iter->second, (uint32)i_timer.GetCurrent());
+
+        // barrier: transports, remove lists and map unloading work across maps
+        m_updater.Wait();
+    }
+    else
+    {
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+        {
+            uint32 startTime = WorldTimer::getMSTime();
+            iter->second->Update((uint32)i_timer.GetCurrent());
+            iter->second->UpdateTimeStats(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+        }
+    }
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
@@ -227,6 +273,10 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    m_updater.Deactivate();
+    m_cellUpdater.Deactivate();
+    m_pathUpdater.Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
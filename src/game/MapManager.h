@@ -28,6 +28,9 @@
 
 #include "Map.h"
 #include "GridStates.h"
+#include "MapUpdater.h"
+#include "MapCellUpdater.h"
+#include "MapPathUpdater.h"
 
 class Transport;
 class BattleGround;
@@ -82,6 +85,15 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
                 i_gridCleanUpDelay = t;
         }
 
+        // worker pool for the active cells of the map, NULL if the map isn't listed in MapUpdate.CellMaps
+        MapCellUpdater* GetCellUpdater(uint32 mapId)
+        {
+            return m_cellUpdater.IsActive() && m_cellUpdateMaps.find(mapId) != m_cellUpdateMaps.end() ? &m_cellUpdater : NULL;
+        }
+
+        // worker pool for PathFinder::requestPath, NULL if mmap.pathThreads = 0
+        MapPathUpdater* GetPathUpdater() { return m_pathUpdater.IsActive() ? &m_pathUpdater : NULL; }
+
         void SetMapUpdateInterval(uint32 t)
         {
             if (t > MIN_MAP_UPDATE_DELAY)
@@ -178,6 +190,16 @@ class MANGOS_DLL_DECL MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
         IntervalTimer i_timer;
+
+        // worker pool for concurrent map updates, inactive if MapUpdate.Threads = 0
+        MapUpdater m_updater;
+
+        // worker pool for concurrent cell updates, inactive if MapUpdate.CellThreads = 0
+        MapCellUpdater m_cellUpdater;
+        std::set<uint32> m_cellUpdateMaps;
+
+        // worker pool for path calculation, inactive if mmap.pathThreads = 0
+        MapPathUpdater m_pathUpdater;
 };
 
 template<typename Do>
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapPathUpdater.h"
+#include "PathFinder.h"
+
+#include <boost/bind.hpp>
+
+MapPathUpdater::MapPathUpdater() : m_cancelationToken(false), m_activated(false)
+{
+}
+
+MapPathUpdater::~MapPathUpdater()
+{
+    Deactivate();
+}
+
+void MapPathUpdater::Activate(size_t numThreads)
+{
+    if (m_activated || !numThreads)
+        return;
+
+    m_cancelationToken = false;
+
+    for (size_t i = 0; i < numThreads; ++i)
+        m_workerThreads.create_thread(boost::bind(&MapPathUpdater::WorkerThread, this));
+
+    m_activated = true;
+}
+
+void MapPathUpdater::Deactivate()
+{
+    if (!m_activated)
+        return;
+
+    // only called while no map is updated, so there are no requests left
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        m_cancelationToken = true;
+    }
+    m_requestCondition.notify_all();
+
+    m_workerThreads.join_all();
+
+    m_activated = false;
+}
+
+void MapPathUpdater::CalculatePaths(std::vector<PathFinder*> const& paths)
+{
+    if (paths.empty())
+        return;
+
+    size_t pending = paths.size();
+
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        for (std::vector<PathFinder*>::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+            m_queue.push_back(PathRequest(*itr, &pending));
+    }
+    m_requestCondition.notify_all();
+
+    boost::unique_lock<boost::mutex> guard(m_lock);
+
+    while (pending > 0)
+        m_finishedCondition.wait(guard);
+}
+
+void MapPathUpdater::WorkerThread()
+{
+    for (;;)
+    {
+        PathRequest request(NULL, NULL);
+
+        {
+            boost::unique_lock<boost::mutex> guard(m_lock);
+
+            while (m_queue.empty() && !m_cancelationToken)
+                m_requestCondition.wait(guard);
+
+            if (m_cancelationToken)
+                break;
+
+            request = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        request.m_path->buildPath();
+
+        {
+            boost::lock_guard<boost::mutex> guard(m_lock);
+            if (--*request.m_pending == 0)
+                m_finishedCondition.notify_all();
+        }
+    }
+}
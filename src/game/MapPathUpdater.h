@@ -0,0 +1,81 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPPATHUPDATER_H
+#define MANGOS_MAPPATHUPDATER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
+#include <vector>
+
+class PathFinder;
+
+/**
+ * Worker pool calculating the paths requested with PathFinder::requestPath.
+ *
+ * Each map collects the path requests of its update and hands them over with CalculatePaths()
+ * at the end of it, which blocks until all of them are calculated. The paths only touch the
+ * navmesh and what PathFinder copied from its unit when the request was made.
+ * Several maps can use the pool at the same time, each of them only waits for its own paths.
+ */
+class MANGOS_DLL_DECL MapPathUpdater
+{
+    public:
+        MapPathUpdater();
+        ~MapPathUpdater();
+
+        void Activate(size_t numThreads);
+        void Deactivate();
+        bool IsActive() const { return m_activated; }
+
+        void CalculatePaths(std::vector<PathFinder*> const& paths);
+
+    private:
+        MapPathUpdater(const MapPathUpdater&);
+        MapPathUpdater& operator=(const MapPathUpdater&);
+
+        struct PathRequest
+        {
+            PathRequest(PathFinder* path, size_t* pending) : m_path(path), m_pending(pending) {}
+
+            PathFinder* m_path;
+            size_t* m_pending;                              ///< paths of the same CalculatePaths() call not done yet
+        };
+
+        void WorkerThread();
+
+        typedef std::deque<PathRequest> RequestQueue;
+        RequestQueue m_queue;
+
+        boost::mutex m_lock;
+        boost::condition_variable m_requestCondition;       ///< signalled when requests are queued or the pool stops
+        boost::condition_variable m_finishedCondition;      ///< signalled when the last path of a call is done
+
+        bool m_cancelationToken;
+        bool m_activated;
+
+        boost::thread_group m_workerThreads;
+};
+
+#endif
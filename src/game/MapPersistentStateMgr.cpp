@@ -237,6 +237,9 @@ bool DungeonPersistentState::CanBeUnload() const
 */
 void DungeonPersistentState::SaveToDB()
 {
+    // instance rows are written on the default async connection, see Player::BindToInstance
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     // state instance data too
     std::string data;
 
@@ -255,6 +258,8 @@ void DungeonPersistentState::SaveToDB()
 
 void DungeonPersistentState::DeleteRespawnTimes()
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM creature_respawn WHERE instance = '%u'", GetInstanceId());
     CharacterDatabase.PExecute("DELETE FROM gameobject_respawn WHERE instance = '%u'", GetInstanceId());
@@ -286,6 +291,8 @@ time_t DungeonPersistentState::GetResetTimeForDB() const
 
 void DungeonPersistentState::UpdateEncounterState(EncounterCreditType type, uint32 creditEntry)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     DungeonEncounterMapBounds bounds = sObjectMgr.GetDungeonEncounterBounds(creditEntry);
 
     for (DungeonEncounterMap::const_iterator iter = bounds.first; iter != bounds.second; ++iter)
@@ -662,6 +669,8 @@ MapPersistentState* MapPersistentStateManager::GetPersistentState(uint32 mapId,
 
 void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     if (instanceid)
     {
         CharacterDatabase.BeginTransaction();
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapUpdater.h"
+#include "Map.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+#include <boost/bind.hpp>
+
+MapUpdater::MapUpdater() : m_pendingRequests(0), m_threadCount(0), m_cancelationToken(false), m_activated(false)
+{
+}
+
+MapUpdater::~MapUpdater()
+{
+    Deactivate();
+}
+
+void MapUpdater::Activate(size_t numThreads)
+{
+    if (m_activated || !numThreads)
+        return;
+
+    m_cancelationToken = false;
+    m_threadCount = numThreads;
+
+    for (size_t i = 0; i < numThreads; ++i)
+        m_workerThreads.create_thread(boost::bind(&MapUpdater::WorkerThread, this));
+
+    m_activated = true;
+}
+
+void MapUpdater::Deactivate()
+{
+    if (!m_activated)
+        return;
+
+    Wait();
+
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        m_cancelationToken = true;
+    }
+    m_requestCondition.notify_all();
+
+    m_workerThreads.join_all();
+
+    m_threadCount = 0;
+    m_activated = false;
+}
+
+void MapUpdater::ScheduleUpdate(Map& map, uint32 diff)
+{
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        ++m_pendingRequests;
+        m_queue.push_back(MapUpdateRequest(&map, diff));
+    }
+    m_requestCondition.notify_one();
+}
+
+void MapUpdater::Wait()
+{
+    boost::unique_lock<boost::mutex> guard(m_lock);
+
+    while (m_pendingRequests > 0)
+        m_finishedCondition.wait(guard);
+}
+
+void MapUpdater::UpdateFinished()
+{
+    boost::lock_guard<boost::mutex> guard(m_lock);
+
+    MANGOS_ASSERT(m_pendingRequests > 0);
+
+    if (--m_pendingRequests == 0)
+        m_finishedCondition.notify_all();
+}
+
+void MapUpdater::WorkerThread()
+{
+    // worker threads can touch any of the databases through map scripts and player saves
+    WorldDatabase.ThreadStart();
+
+    for (;;)
+    {
+        MapUpdateRequest request(NULL, 0);
+
+        {
+            boost::unique_lock<boost::mutex> guard(m_lock);
+
+            while (m_queue.empty() && !m_cancelationToken)
+                m_requestCondition.wait(guard);
+
+            if (m_cancelationToken)
+                break;
+
+            request = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        uint32 startTime = WorldTimer::getMSTime();
+        request.m_map->Update(request.m_diff);
+        request.m_map->UpdateTimeStats(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+
+        UpdateFinished();
+    }
+
+    WorldDatabase.ThreadEnd();
+}
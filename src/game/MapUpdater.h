@@ -0,0 +1,85 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPUPDATER_H
+#define MANGOS_MAPUPDATER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
+
+class Map;
+
+/**
+ * Worker pool used by MapManager to update independent maps concurrently.
+ *
+ * Maps are scheduled one by one with ScheduleUpdate() and picked up by the worker
+ * threads in order. Wait() blocks the world thread until every scheduled map has
+ * finished its Update(), it is the barrier after which cross-map work (transports,
+ * remove lists, map unloading) is allowed again.
+ */
+class MANGOS_DLL_DECL MapUpdater
+{
+    public:
+        MapUpdater();
+        ~MapUpdater();
+
+        void Activate(size_t numThreads);
+        void Deactivate();
+        bool IsActive() const { return m_activated; }
+        size_t GetThreadCount() const { return m_threadCount; }
+
+        void ScheduleUpdate(Map& map, uint32 diff);
+        void Wait();
+
+    private:
+        MapUpdater(const MapUpdater&);
+        MapUpdater& operator=(const MapUpdater&);
+
+        struct MapUpdateRequest
+        {
+            MapUpdateRequest(Map* map, uint32 diff) : m_map(map), m_diff(diff) {}
+
+            Map* m_map;
+            uint32 m_diff;
+        };
+
+        void WorkerThread();
+        void UpdateFinished();
+
+        typedef std::deque<MapUpdateRequest> RequestQueue;
+        RequestQueue m_queue;
+
+        boost::mutex m_lock;
+        boost::condition_variable m_requestCondition;       ///< signalled when a request is queued or the pool stops
+        boost::condition_variable m_finishedCondition;      ///< signalled when the last pending request is done
+
+        size_t m_pendingRequests;
+        size_t m_threadCount;
+        bool m_cancelationToken;
+        bool m_activated;
+
+        boost::thread_group m_workerThreads;
+};
+
+#endif
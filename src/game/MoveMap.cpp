@@ -23,6 +23,10 @@
 #include "MoveMap.h"
 #include "MoveMapSharedDefines.h"
 
+#include <boost/thread/lock_guard.hpp>
+
+#include <limits>
+
 namespace MMAP
 {
     // ######################## MMapFactory ########################
@@ -123,7 +127,7 @@ namespace MMAP
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, ++tileGeneration);
         mmap_data->mmapLoadedTiles.clear();
 
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
@@ -137,6 +141,8 @@ namespace MMAP
 
     bool MMapManager::loadMap(uint32 mapId, int32 x, int32 y)
     {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+
         // make sure the mmap is loaded and ready to load tiles
         if (!loadMapData(mapId))
             return false;
@@ -203,7 +209,15 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef) != DT_SUCCESS)
+        dtStatus addResult;
+        {
+            boost::unique_lock<boost::shared_mutex> meshGuard(mmap->navMeshLock);
+            addResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+            if (addResult == DT_SUCCESS)
+                logTileChange(mmap, header);
+        }
+
+        if (addResult != DT_SUCCESS)
         {
             sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
             dtFree(data);
@@ -218,6 +232,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+
         // check if we have this map loaded
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
@@ -240,7 +256,15 @@ namespace MMAP
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
         // unload, and mark as non loaded
-        if (DT_SUCCESS != mmap->navMesh->removeTile(tileRef, NULL, NULL))
+        dtStatus removeResult;
+        {
+            boost::unique_lock<boost::shared_mutex> meshGuard(mmap->navMeshLock);
+            dtMeshTile const* tile = mmap->navMesh->getTileByRef(tileRef);
+            logTileChange(mmap, tile ? tile->header : NULL);
+            removeResult = mmap->navMesh->removeTile(tileRef, NULL, NULL);
+        }
+
+        if (DT_SUCCESS != removeResult)
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
@@ -261,6 +285,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
         {
             // file may not exist, therefore not loaded
@@ -270,6 +296,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = loadedMMaps[mapId];
+        boost::unique_lock<boost::shared_mutex> meshGuard(mmap->navMeshLock);
         for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -283,6 +310,7 @@ namespace MMAP
             }
         }
 
+        meshGuard.unlock();
         delete mmap;
         loadedMMaps.erase(mapId);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
@@ -290,62 +318,104 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapData* mmap = GetMMapData(mapId);
+        return mmap ? mmap->navMesh : NULL;
+    }
+
+    MMapData* MMapManager::GetMMapData(uint32 mapId)
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        return itr != loadedMMaps.end() ? itr->second : NULL;
+    }
+
+    void MMapManager::logTileChange(MMapData* mmap, dtMeshHeader const* header)
+    {
+        TileChange change;
+        change.previousGeneration = mmap->tileGeneration;
+        change.generation = ++tileGeneration;
+
+        if (header)
         {
-            // file may not exist, therefore not loaded
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
+            // detour coords are (y, z, x)
+            change.minX = header->bmin[2];
+            change.minY = header->bmin[0];
+            change.maxX = header->bmax[2];
+            change.maxY = header->bmax[0];
         }
-
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        else
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
+            change.minX = change.minY = -std::numeric_limits<float>::max();
+            change.maxX = change.maxY = std::numeric_limits<float>::max();
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
-
-        return true;
+        mmap->tileGeneration = change.generation;
+        mmap->tileChanges.push_back(change);
+        if (mmap->tileChanges.size() > MAX_LOGGED_TILE_CHANGES)
+            mmap->tileChanges.pop_front();
     }
 
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
+    // ######################## NavMeshQueryHolder ########################
+    NavMeshQueryHolder::NavMeshQueryHolder(uint32 mapId) : m_data(NULL), m_query(NULL)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-            return NULL;
+        MMapManager* manager = MMapFactory::createOrGetMMapManager();
+        MMapData* mmap;
+        {
+            // unloadMap() deletes the mmap under m_lock once it gets the mesh exclusively,
+            // so the shared lock has to be taken before m_lock is released. Tiles are only changed
+            // with m_lock held, so this never waits for a writer while blocking the others.
+            boost::lock_guard<boost::mutex> guard(manager->m_lock);
 
-        return loadedMMaps[mapId]->navMesh;
-    }
+            MMapDataSet::const_iterator itr = manager->loadedMMaps.find(mapId);
+            if (itr == manager->loadedMMaps.end())
+                return;
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
-    {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-            return NULL;
+            mmap = itr->second;
+            mmap->navMeshLock.lock_shared();
+        }
 
-        MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
         {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            MANGOS_ASSERT(query);
-            if (DT_SUCCESS != query->init(mmap->navMesh, 1024))
+            boost::lock_guard<boost::mutex> guard(mmap->queryLock);
+            if (!mmap->navMeshQueries.empty())
             {
-                dtFreeNavMeshQuery(query);
-                sLog.outError("MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return NULL;
+                m_query = mmap->navMeshQueries.back();
+                mmap->navMeshQueries.pop_back();
             }
+        }
+
+        if (!m_query)
+        {
+            // allocate mesh query, the pool grows up to the number of concurrent searches on the map
+            m_query = dtAllocNavMeshQuery();
+            MANGOS_ASSERT(m_query);
+            if (DT_SUCCESS != m_query->init(mmap->navMesh, 1024))
+            {
+                dtFreeNavMeshQuery(m_query);
+                m_query = NULL;
+                mmap->navMeshLock.unlock_shared();
+                sLog.outError("MMAP:NavMeshQueryHolder: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
+                return;
+            }
+
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:NavMeshQueryHolder: created dtNavMeshQuery for mapId %03u", mapId);
+        }
+
+        m_data = mmap;
+    }
 
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+    NavMeshQueryHolder::~NavMeshQueryHolder()
+    {
+        if (!m_data)
+            return;
+
+        {
+            boost::lock_guard<boost::mutex> guard(m_data->queryLock);
+            m_data->navMeshQueries.push_back(m_query);
         }
 
-        return mmap->navMeshQueries[instanceId];
+        m_data->navMeshLock.unlock_shared();
     }
 }
@@ -21,6 +21,12 @@
 
 #include "Utilities/UnorderedMapSet.h"
 
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <deque>
+#include <vector>
+
 #include "detour/DetourAlloc.h"
 #include "detour/DetourNavMesh.h"
 #include "detour/DetourNavMeshQuery.h"
@@ -36,20 +42,34 @@ inline void dtCustomFree(void* ptr)
     delete[](unsigned char*)ptr;
 }
 
+// tile changes kept per navmesh for the path caches of its maps
+#define MAX_LOGGED_TILE_CHANGES 64
+
 //  move map related classes
 namespace MMAP
 {
     typedef UNORDERED_MAP<uint32, dtTileRef> MMapTileSet;
-    typedef UNORDERED_MAP<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::vector<dtNavMeshQuery*> NavMeshQueryPool;
+
+    // a tile added to or removed from a navmesh, PathCache only drops the paths near it
+    struct TileChange
+    {
+        uint32 previousGeneration;          // tile generation of the navmesh before the change
+        uint32 generation;                  // and after it
+        float minX, minY, maxX, maxY;       // world bounds of the tile
+    };
+
+    // most recent change last, a cache older than the first entry drops all of its paths
+    typedef std::deque<TileChange> TileChangeLog;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh, uint32 generation) : navMesh(mesh), tileGeneration(generation) {}
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+            for (NavMeshQueryPool::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
+                dtFreeNavMeshQuery(*i);
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
@@ -57,9 +77,13 @@ namespace MMAP
 
         dtNavMesh* navMesh;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery is not thread safe, every search takes an unused query of the map from the pool
+        NavMeshQueryPool navMeshQueries;    // queries not in use
+        boost::mutex queryLock;             // guards navMeshQueries
+        boost::shared_mutex navMeshLock;    // shared while the mesh is searched, exclusive while tiles are added or removed
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        uint32 tileGeneration;              // changed whenever tiles are added or removed, see PathCache
+        TileChangeLog tileChanges;          // the last changes of tileGeneration
     };
 
     typedef UNORDERED_MAP<uint32, MMapData*> MMapDataSet;
@@ -68,17 +92,17 @@ namespace MMAP
     // holds all all access to mmap loading unloading and meshes
     class MMapManager
     {
+            friend class NavMeshQueryHolder;
+
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), tileGeneration(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // use NavMeshQueryHolder to search the mesh, its tiles can change while it is not held
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
@@ -86,9 +110,40 @@ namespace MMAP
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            MMapData* GetMMapData(uint32 mapId);
+            // new tile generation of the mesh, called with its navMeshLock held exclusively
+            void logTileChange(MMapData* mmap, dtMeshHeader const* header);
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            uint32 tileGeneration;              // last generation handed to a navmesh, unique across unload and reload of a map
+
+            // map threads load and unload tiles at the same time
+            boost::mutex m_lock;
+    };
+
+    // takes a navmesh query of the map from its pool for exclusive use
+    // and keeps the tiles of the navmesh from changing while it is held
+    class NavMeshQueryHolder
+    {
+        public:
+            explicit NavMeshQueryHolder(uint32 mapId);
+            ~NavMeshQueryHolder();
+
+            // both NULL if the map has no navmesh
+            dtNavMesh const* GetNavMesh() const { return m_data ? m_data->navMesh : NULL; }
+            dtNavMeshQuery const* GetQuery() const { return m_query; }
+            // paths found in the navmesh are only valid while its tiles stay the same
+            uint32 GetTileGeneration() const { return m_data ? m_data->tileGeneration : 0; }
+            // only valid while held, empty if the map has no navmesh
+            TileChangeLog const* GetTileChanges() const { return m_data ? &m_data->tileChanges : NULL; }
+
+        private:
+            NavMeshQueryHolder(const NavMeshQueryHolder&);
+            NavMeshQueryHolder& operator=(const NavMeshQueryHolder&);
+
+            MMapData* m_data;
+            dtNavMeshQuery* m_query;
     };
 
     // static class
@@ -45,7 +45,7 @@
 #include "CreatureLinkingMgr.h"
 #include "Chat.h"
 
-Object::Object()
+Object::Object() : m_clientUpdateLink(this)
 {
     m_objectTypeId      = TYPEID_OBJECT;
     m_objectType        = TYPEMASK_OBJECT;
@@ -80,7 +80,7 @@ void Object::_InitValues()
     m_uint32Values = new uint32[ m_valuesCount ];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    m_changedValues.resize(m_valuesCount, false);
+    m_changedValues.SetCount(m_valuesCount);
 
     m_objectUpdated = false;
 }
@@ -223,6 +223,29 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, SharedValuesUpdateBlock& block) const
+{
+    if (!block.m_built)
+    {
+        block.m_data.reserve(500);
+        block.m_data << uint8(UPDATETYPE_VALUES);
+        block.m_data << GetPackGUID();
+
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(&updateMask, target);
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block.m_data, &updateMask, target, &block.m_targetFields);
+
+        block.m_built = true;
+    }
+
+    size_t pos = data->AddUpdateBlock(block.m_data);
+
+    for (UpdateFieldPositions::const_iterator itr = block.m_targetFields.begin(); itr != block.m_targetFields.end(); ++itr)
+        data->PutUpdateValue(pos + itr->second, GetUpdateFieldValueForTarget(itr->first, target));
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetObjectGuid());
@@ -406,49 +429,32 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, UpdateFieldPositions* targetFields /*= NULL*/) const
 {
     if (!target)
         return;
 
-    bool IsActivateToQuest = false;
-    bool IsPerCasterAuraState = false;
-
     if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
     {
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
-        {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
             updateMask->SetBit(GAMEOBJECT_DYNAMIC);
-        }
         else if (isType(TYPEMASK_UNIT))
         {
             if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
                 updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
         }
     }
     else                                                    // case UPDATETYPE_VALUES
     {
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
             updateMask->SetBit(GAMEOBJECT_DYNAMIC);
             updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
         }
         else if (isType(TYPEMASK_UNIT))
         {
             if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
                 updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
         }
     }
 
@@ -460,157 +466,183 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->FindNextBit(0); index < m_valuesCount; index = updateMask->FindNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (IsTargetDependentUpdateField(index))
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
-
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
-                    }
-
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                    }
-                    else
-                        *data << m_uint32Values[index];
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
+                if (targetFields)
+                    targetFields->push_back(UpdateFieldPositions::value_type(index, data->wpos()));
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
+                *data << GetUpdateFieldValueForTarget(index, target);
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                // hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    if (!target->isAllowedToLoot((Creature*)this))
-                        *data << (m_uint32Values[index] & ~(UNIT_DYNFLAG_LOOTABLE | UNIT_DYNFLAG_TAPPED_BY_PLAYER));
-                    else
-                    {
-                        // flag only for original loot recipent
-                        if (target->GetObjectGuid() == ((Creature*)this)->GetLootRecipientGuid())
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER));
-                    }
-                }
-                else
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
-                }
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
+            else
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
             }
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->FindNextBit(0); index < m_valuesCount; index = updateMask->FindNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (IsTargetDependentUpdateField(index))
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
+                if (targetFields)
+                    targetFields->push_back(UpdateFieldPositions::value_type(index, data->wpos()));
+
+                *data << GetUpdateFieldValueForTarget(index, target);
+            }
+            else
+                *data << m_uint32Values[index];             // other cases
+        }
+    }
+    else                                                    // other objects case (no special index checks)
+    {
+        for (uint16 index = updateMask->FindNextBit(0); index < m_valuesCount; index = updateMask->FindNextBit(index + 1))
+        {
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[index];
+        }
+    }
+}
+
+bool Object::IsTargetDependentUpdateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+                return GetTypeId() == TYPEID_UNIT;
+            case UNIT_FIELD_AURASTATE:
+            case UNIT_FIELD_FLAGS:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYNAMIC;
+
+    return false;
+}
+
+uint32 Object::GetUpdateFieldValueForTarget(uint16 index, Player* target) const
+{
+    uint32 value = m_uint32Values[index];
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            {
+                if (GetTypeId() != TYPEID_UNIT)
+                    break;
+
+                if (!target->canSeeSpellClickOn((Creature*)this))
+                    value &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+                if (value & UNIT_NPC_FLAG_TRAINER)
                 {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
-
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
-                    }
+                    if (!((Creature*)this)->IsTrainerOf(target, false))
+                        value &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
                 }
-                else
-                    *data << m_uint32Values[index];         // other cases
+
+                if (value & UNIT_NPC_FLAG_STABLEMASTER)
+                {
+                    if (target->getClass() != CLASS_HUNTER)
+                        value &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                }
+                break;
             }
+            case UNIT_FIELD_AURASTATE:
+            {
+                // related pet caster aura state is only shown to its caster
+                if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE) &&
+                        !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                    value &= ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+                break;
+            }
+            case UNIT_FIELD_FLAGS:
+            {
+                // Gamemasters should be always able to select units - remove not selectable flag
+                if (target->isGameMaster())
+                    value &= ~UNIT_FLAG_NOT_SELECTABLE;
+                break;
+            }
+            case UNIT_DYNAMIC_FLAGS:
+            {
+                if (GetTypeId() != TYPEID_UNIT)
+                    break;
+
+                // hide lootable animation for unallowed players
+                if (!target->isAllowedToLoot((Creature*)this))
+                    value &= ~(UNIT_DYNFLAG_LOOTABLE | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                // flag only for original loot recipent
+                else if (target->GetObjectGuid() != ((Creature*)this)->GetLootRecipientGuid())
+                    value &= ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                break;
+            }
+            default:
+                break;
         }
     }
-    else                                                    // other objects case (no special index checks)
+    else if (isType(TYPEMASK_GAMEOBJECT) && index == GAMEOBJECT_DYNAMIC)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+        //      most likely related to "can enter map" and then should be 0 if can not enter
+
+        // hi part is always -1, lo part holds the flags
+        value = 0xFFFF0000;
+
+        GameObject const* go = (GameObject const*)this;
+        if (!go->IsTransport() && (go->ActivateToQuest(target) || target->isGameMaster()))
         {
-            if (updateMask->GetBit(index))
+            switch (go->GetGoType())
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
+                    value |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GENERIC:
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    value |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                default:
+                    // unknown, not happen.
+                    break;
             }
         }
+        // else disable quest object
     }
+
+    return value;
 }
 
 void Object::ClearUpdateMask(bool remove)
 {
-    if (m_uint32Values)
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
-    }
+    m_changedValues.Clear();
 
     if (m_objectUpdated)
     {
@@ -641,9 +673,7 @@ bool Object::LoadValues(const char* data)
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index])
-            updateMask->SetBit(index);
+    *updateMask |= m_changedValues;
 }
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* /*target*/) const
@@ -660,7 +690,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -672,7 +702,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -684,8 +714,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        m_changedValues.SetBit(index);
+        m_changedValues.SetBit(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -697,7 +727,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -716,7 +746,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -735,7 +765,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -797,7 +827,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -811,7 +841,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -829,7 +859,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -847,7 +877,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -859,7 +889,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -871,7 +901,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -892,7 +922,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, SharedValuesUpdateBlock* block /*= NULL*/)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -903,7 +933,10 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (block)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *block);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
 void Object::AddToClientUpdateList()
@@ -1850,6 +1883,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    SharedValuesUpdateBlock i_block;                        // built for the first viewer, copied for the others
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -1864,7 +1898,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_block);
         }
     }
 
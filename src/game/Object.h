@@ -23,11 +23,14 @@
 #include "ByteBuffer.h"
 #include "UpdateFields.h"
 #include "UpdateData.h"
+#include "UpdateMask.h"
 #include "ObjectGuid.h"
 #include "Camera.h"
+#include "Utilities/LinkedList.h"
 
 #include <set>
 #include <string>
+#include <vector>
 
 #define CONTACT_DISTANCE            0.5f
 #define INTERACTION_DISTANCE        5.0f
@@ -64,13 +67,13 @@ enum PhaseMasks
 
 class WorldPacket;
 class UpdateData;
+class Object;
 class WorldSession;
 class Creature;
 class Player;
 class Unit;
 class Group;
 class Map;
-class UpdateMask;
 class InstanceData;
 class TerrainInfo;
 class TransportInfo;
@@ -78,6 +81,36 @@ struct MangosStringLocale;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+/// Link of an object in the client update list of its map, see Map::AddUpdateObject
+class ClientUpdateLink : public LinkedListElement
+{
+    public:
+        explicit ClientUpdateLink(Object* object) : m_object(object) {}
+
+        Object* GetUpdatedObject() const { return m_object; }
+
+    private:
+        Object* m_object;
+};
+
+typedef std::vector<std::pair<uint16, size_t> > UpdateFieldPositions;
+
+/**
+ * Values update block of an object built once for all players seeing it except the object itself.
+ *
+ * The update mask and the field values are the same for all these viewers, only a few fields
+ * (npc flags, dynamic flags, per caster aura state, quest activated gameobjects, ...) depend on
+ * the viewer. Their positions are recorded and they are rewritten in each viewer's copy.
+ */
+struct SharedValuesUpdateBlock
+{
+    SharedValuesUpdateBlock() : m_data(0), m_built(false) {}   // storage is reserved when the block is built
+
+    ByteBuffer m_data;
+    UpdateFieldPositions m_targetFields;                    ///< viewer dependent fields and their position in m_data
+    bool m_built;
+};
+
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -168,9 +201,11 @@ class MANGOS_DLL_SPEC Object
         virtual void RemoveFromClientUpdateList();
         virtual void BuildUpdateData(UpdateDataMapType& update_players);
         void MarkForClientUpdate();
+        ClientUpdateLink& GetClientUpdateLink() { return m_clientUpdateLink; }
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, SharedValuesUpdateBlock& block) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint16 flags = 0) const;
 
@@ -371,8 +406,10 @@ class MANGOS_DLL_SPEC Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, UpdateFieldPositions* targetFields = NULL) const;
+        bool IsTargetDependentUpdateField(uint16 index) const;
+        uint32 GetUpdateFieldValueForTarget(uint16 index, Player* target) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, SharedValuesUpdateBlock* block = NULL);
 
         uint16 m_objectType;
 
@@ -386,11 +423,12 @@ class MANGOS_DLL_SPEC Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        UpdateMask m_changedValues;
 
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        ClientUpdateLink m_clientUpdateLink;
 
     private:
         bool m_inWorld;
@@ -1313,8 +1313,17 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+
+    // the spawns are streamed, so the row count for the progress bar is queried separately
+    uint32 rowCount = 0;
+    if (QueryResult* countResult = WorldDatabase.Query("SELECT COUNT(*) FROM creature"))
+    {
+        rowCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                      0                       1   2    3
+    QueryResult* result = WorldDatabase.QueryStream("SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7           8            9              10         11
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
                           //   12         13       14          15            16         17         18
@@ -1353,7 +1362,7 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(rowCount);
 
     do
     {
@@ -1486,7 +1495,10 @@ void ObjectMgr::LoadCreatures()
         }
 
         if (gameEvent == 0 && GuidPoolId == 0 && EntryPoolId == 0) // if not this is to be managed by GameEvent System or Pool system
+        {
+            boost::lock_guard<boost::mutex> guard(m_loadGridLock);
             AddCreatureToGrid(guid, &data);
+        }
 
         ++count;
     }
@@ -1534,8 +1546,16 @@ void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                0                           1   2    3           4           5           6
-    QueryResult* result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    // the spawns are streamed, so the row count for the progress bar is queried separately
+    uint32 rowCount = 0;
+    if (QueryResult* countResult = WorldDatabase.Query("SELECT COUNT(*) FROM gameobject"))
+    {
+        rowCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                      0                           1   2    3           4           5           6
+    QueryResult* result = WorldDatabase.QueryStream("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           //   7          8          9          10         11             12            13     14         15         16
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, event,"
                           //   17                          18
@@ -1564,7 +1584,7 @@ void ObjectMgr::LoadGameObjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(rowCount);
 
     do
     {
@@ -1680,7 +1700,10 @@ void ObjectMgr::LoadGameObjects()
         }
 
         if (gameEvent == 0 && GuidPoolId == 0 && EntryPoolId == 0) // if not this is to be managed by GameEvent System or Pool system
+        {
+            boost::lock_guard<boost::mutex> guard(m_loadGridLock);
             AddGameobjectToGrid(guid, &data);
+        }
 
         //uint32 zoneId, areaId;
         //sTerrainMgr.LoadTerrain(data.mapid)->GetZoneAndAreaId(zoneId, areaId, data.posX, data.posY, data.posZ);
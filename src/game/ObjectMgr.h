@@ -41,6 +41,8 @@
 #include <map>
 #include <limits>
 
+#include <boost/thread/mutex.hpp>
+
 class Group;
 class ArenaTeam;
 class Item;
@@ -1248,6 +1250,7 @@ class ObjectMgr
         CreatureClassLvlStats m_creatureClassLvlStats[DEFAULT_MAX_CREATURE_LEVEL + 1][MAX_CREATURE_CLASS][MAX_EXPANSION + 1];
 
         MapObjectGuids mMapObjectGuids;
+        boost::mutex m_loadGridLock;                        // LoadCreatures() and LoadGameObjects() fill mMapObjectGuids concurrently
         CreatureDataMap mCreatureDataMap;
         CreatureLocaleMap mCreatureLocaleMap;
         GameObjectDataMap mGameObjectDataMap;
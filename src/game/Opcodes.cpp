@@ -1338,3 +1338,35 @@ OpcodeHandler opcodeTable[NUM_MSG_TYPES] =
     /*0x51D*/ { "SMSG_COMMENTATOR_SKIRMISH_QUEUE_RESULT2",      STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide               },
     /*0x51E*/ { "SMSG_COMPRESSED_UNKNOWN_1310",                 STATUS_NEVER,    PROCESS_INPLACE,      &WorldSession::Handle_ServerSide               },
 };
+
+OpcodeSizeStats opcodeSizeStats[NUM_MSG_TYPES];
+
+void RecordSentPacket(uint16 id, size_t size, bool outgrown)
+{
+    if (id >= NUM_MSG_TYPES)
+        return;
+
+    OpcodeSizeStats& stats = opcodeSizeStats[id];
+
+    ++stats.sent;
+    stats.totalSize += size;
+
+    if (outgrown)
+        ++stats.outgrown;
+
+    // on failure maxSize is reloaded with the value stored meanwhile by another thread
+    uint32 maxSize = stats.maxSize.load(boost::memory_order_relaxed);
+    while (size > maxSize)
+        if (stats.maxSize.compare_exchange_weak(maxSize, uint32(size), boost::memory_order_relaxed))
+            break;
+
+    // raised to a bigger packet at once, lowered by 1/16 of the difference to a smaller one. So it stays
+    // near the large end of the recent sizes and forgets a single huge packet after some dozen smaller ones
+    uint32 predictedSize = stats.predictedSize.load(boost::memory_order_relaxed);
+    for (;;)
+    {
+        uint32 newSize = size >= predictedSize ? uint32(size) : predictedSize - (predictedSize - uint32(size) + 15) / 16;
+        if (newSize == predictedSize || stats.predictedSize.compare_exchange_weak(predictedSize, newSize, boost::memory_order_relaxed))
+            break;
+    }
+}
@@ -25,6 +25,8 @@
 
 #include "Common.h"
 
+#include <boost/atomic.hpp>
+
 // Note: this include need for be sure have full definition of class WorldSession
 //       if this class definition not complite then VS for x64 release use different size for
 //       struct OpcodeHandler in this header and Opcode.cpp and get totally wrong data from
@@ -1385,5 +1387,32 @@ inline const char* LookupOpcodeName(uint16 id)
         return "Received unknown opcode, it's more than max!";
     return opcodeTable[id].name;
 }
+
+/// Sizes of the packets sent to clients with an opcode, see RecordSentPacket
+struct OpcodeSizeStats
+{
+    boost::atomic<uint32> sent;
+    boost::atomic<uint32> outgrown;                         ///< packets that needed more storage than reserved at creation
+    boost::atomic<uint32> maxSize;
+    boost::atomic<uint64> totalSize;
+    boost::atomic<uint32> predictedSize;                    ///< follows a bigger packet at once, decays to smaller ones
+};
+
+extern OpcodeSizeStats opcodeSizeStats[NUM_MSG_TYPES];
+
+#define MAX_PREDICTED_PACKET_SIZE 1024
+
+void RecordSentPacket(uint16 id, size_t size, bool outgrown);
+
+/// Storage to reserve for a new packet: the given reserve, raised to the size of the large packets recently sent
+/// with the opcode. Bigger packets than MAX_PREDICTED_PACKET_SIZE are rare and left to the reserve of their builder.
+inline size_t PredictPacketSize(uint16 id, size_t reserve)
+{
+    if (id >= NUM_MSG_TYPES)
+        return reserve;
+
+    size_t predictedSize = std::min<size_t>(opcodeSizeStats[id].predictedSize.load(boost::memory_order_relaxed), MAX_PREDICTED_PACKET_SIZE);
+    return std::max(reserve, predictedSize);
+}
 #endif
 /// @}
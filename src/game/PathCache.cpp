@@ -0,0 +1,187 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PathCache.h"
+#include "MoveMap.h"
+
+#include <boost/thread/lock_guard.hpp>
+
+#include <algorithm>
+#include <limits>
+
+PathCache::PathCache(uint32 capacity) : m_capacity(capacity), m_tileGeneration(0)
+{
+}
+
+bool PathCache::Find(PathCacheKey const& key, MMAP::NavMeshQueryHolder const& mesh, dtPolyRef* path, uint32& length, uint32 maxLength)
+{
+    if (!m_capacity)
+        return false;
+
+    boost::lock_guard<boost::mutex> guard(m_lock);
+
+    CheckGeneration(mesh);
+
+    EntryMap::iterator itr = m_entryMap.find(key);
+
+    // a cut off corridor would not reach the end polygon, let findPath() report the partial result
+    if (itr == m_entryMap.end() || itr->second->m_path.size() > maxLength)
+    {
+        ++m_stats.m_misses;
+        return false;
+    }
+
+    ++m_stats.m_hits;
+
+    // move to the front, it was just used
+    m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+    std::vector<dtPolyRef> const& cached = itr->second->m_path;
+    length = cached.size();
+    std::copy(cached.begin(), cached.end(), path);
+    return true;
+}
+
+void PathCache::Insert(PathCacheKey const& key, MMAP::NavMeshQueryHolder const& mesh, dtPolyRef const* path, uint32 length)
+{
+    if (!m_capacity || !length)
+        return;
+
+    Entry entry(key, path, length);
+
+    // bounds of the corridor, for the paths to drop when tiles or collision change
+    entry.m_minX = entry.m_minY = std::numeric_limits<float>::max();
+    entry.m_maxX = entry.m_maxY = -std::numeric_limits<float>::max();
+
+    dtNavMesh const* navMesh = mesh.GetNavMesh();
+    for (uint32 i = 0; i < length; ++i)
+    {
+        dtMeshTile const* tile;
+        dtPoly const* poly;
+        if (navMesh->getTileAndPolyByRef(path[i], &tile, &poly) != DT_SUCCESS)
+            return;
+
+        for (uint8 v = 0; v < poly->vertCount; ++v)
+        {
+            // detour coords are (y, z, x)
+            float const* vert = &tile->verts[poly->verts[v] * 3];
+            entry.m_minX = std::min(entry.m_minX, vert[2]);
+            entry.m_minY = std::min(entry.m_minY, vert[0]);
+            entry.m_maxX = std::max(entry.m_maxX, vert[2]);
+            entry.m_maxY = std::max(entry.m_maxY, vert[0]);
+        }
+    }
+
+    boost::lock_guard<boost::mutex> guard(m_lock);
+
+    CheckGeneration(mesh);
+
+    EntryMap::iterator itr = m_entryMap.find(key);
+    if (itr != m_entryMap.end())
+    {
+        // found by another request in the meantime
+        *itr->second = entry;
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+        m_entryMap.erase(m_entries.back().m_key);
+        m_entries.pop_back();
+    }
+
+    m_entries.push_front(entry);
+    m_entryMap[key] = m_entries.begin();
+}
+
+void PathCache::Invalidate(float minX, float minY, float maxX, float maxY)
+{
+    if (!m_capacity)
+        return;
+
+    boost::lock_guard<boost::mutex> guard(m_lock);
+    DropArea(minX, minY, maxX, maxY);
+}
+
+PathCache::Stats PathCache::GetStats()
+{
+    boost::lock_guard<boost::mutex> guard(m_lock);
+
+    Stats stats = m_stats;
+    stats.m_size = m_entries.size();
+    return stats;
+}
+
+void PathCache::ResetStats()
+{
+    boost::lock_guard<boost::mutex> guard(m_lock);
+    m_stats = Stats();
+}
+
+void PathCache::CheckGeneration(MMAP::NavMeshQueryHolder const& mesh)
+{
+    uint32 tileGeneration = mesh.GetTileGeneration();
+    if (tileGeneration == m_tileGeneration)
+        return;
+
+    uint32 oldGeneration = m_tileGeneration;
+    m_tileGeneration = tileGeneration;
+
+    if (m_entries.empty())
+        return;
+
+    // find the first change after the last lookup, if it is not logged anymore nothing can be kept
+    MMAP::TileChangeLog const& changes = *mesh.GetTileChanges();
+    MMAP::TileChangeLog::const_iterator itr = changes.begin();
+    while (itr != changes.end() && itr->previousGeneration != oldGeneration)
+        ++itr;
+
+    if (itr == changes.end())
+    {
+        Clear();
+        return;
+    }
+
+    for (; itr != changes.end(); ++itr)
+        DropArea(itr->minX, itr->minY, itr->maxX, itr->maxY);
+}
+
+void PathCache::DropArea(float minX, float minY, float maxX, float maxY)
+{
+    for (EntryList::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        // touching counts, a tile added next to a path can link a shorter one
+        if (itr->m_maxX < minX || itr->m_minX > maxX || itr->m_maxY < minY || itr->m_minY > maxY)
+        {
+            ++itr;
+            continue;
+        }
+
+        m_entryMap.erase(itr->m_key);
+        itr = m_entries.erase(itr);
+        ++m_stats.m_invalidations;
+    }
+}
+
+void PathCache::Clear()
+{
+    m_stats.m_invalidations += m_entries.size();
+    m_entries.clear();
+    m_entryMap.clear();
+}
@@ -0,0 +1,149 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATHCACHE_H
+#define MANGOS_PATHCACHE_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+#include "Utilities/UnorderedMapSet.h"
+#include "detour/DetourNavMesh.h"
+
+#include <boost/thread/mutex.hpp>
+
+#include <list>
+#include <vector>
+
+namespace MMAP
+{
+    class NavMeshQueryHolder;
+}
+
+/// Start and end polygon of a cached path, with the filter flags it was searched with
+struct PathCacheKey
+{
+    PathCacheKey(dtPolyRef start, dtPolyRef end, uint16 includeFlags, uint16 excludeFlags) :
+        m_startPoly(start), m_endPoly(end), m_flags(uint32(includeFlags) << 16 | excludeFlags) {}
+
+    bool operator==(PathCacheKey const& key) const
+    {
+        return m_startPoly == key.m_startPoly && m_endPoly == key.m_endPoly && m_flags == key.m_flags;
+    }
+
+    bool operator<(PathCacheKey const& key) const
+    {
+        if (m_startPoly != key.m_startPoly)
+            return m_startPoly < key.m_startPoly;
+        if (m_endPoly != key.m_endPoly)
+            return m_endPoly < key.m_endPoly;
+        return m_flags < key.m_flags;
+    }
+
+    dtPolyRef m_startPoly;
+    dtPolyRef m_endPoly;
+    uint32 m_flags;                                         ///< include flags << 16 | exclude flags
+};
+
+HASH_NAMESPACE_START
+
+template<>
+class hash<PathCacheKey>
+{
+    public:
+
+        size_t operator()(PathCacheKey const& key) const
+        {
+            return hash<uint64>()(key.m_startPoly * 31 + key.m_endPoly) ^ key.m_flags;
+        }
+};
+
+HASH_NAMESPACE_END
+
+/**
+ * Least recently used cache of the polygon paths found by PathFinder in one map.
+ *
+ * Many units chase or wander between the same polygons, instead of running the A* search of the
+ * navmesh again the corridor found for the start and end polygon is reused. Only the polygons are
+ * cached, the point path is still built from the exact start and end position of every request.
+ *
+ * The navmesh of a map is shared by all of its instances and can change when tiles are loaded or
+ * unloaded. Every lookup passes the navmesh it searches, the paths crossing the tiles changed since
+ * the last lookup are dropped. Each entry keeps the bounds of its polygons for that. Paths are built
+ * on the map path workers too, so the cache is locked.
+ */
+class MANGOS_DLL_DECL PathCache
+{
+    public:
+        explicit PathCache(uint32 capacity);
+
+        // copies the cached path into path, false if not cached or longer than maxLength
+        bool Find(PathCacheKey const& key, MMAP::NavMeshQueryHolder const& mesh, dtPolyRef* path, uint32& length, uint32 maxLength);
+        // path has to be a complete path found in the held navmesh
+        void Insert(PathCacheKey const& key, MMAP::NavMeshQueryHolder const& mesh, dtPolyRef const* path, uint32 length);
+
+        // drops the paths crossing the given area, e.g. when the collision there changed
+        void Invalidate(float minX, float minY, float maxX, float maxY);
+
+        struct Stats
+        {
+            Stats() : m_hits(0), m_misses(0), m_invalidations(0), m_size(0) {}
+
+            uint32 m_hits;
+            uint32 m_misses;
+            uint32 m_invalidations;                         ///< paths dropped because the navmesh or collision changed
+            uint32 m_size;                                  ///< paths currently cached
+        };
+
+        Stats GetStats();
+        void ResetStats();
+
+        uint32 GetCapacity() const { return m_capacity; }
+
+    private:
+        PathCache(const PathCache&);
+        PathCache& operator=(const PathCache&);
+
+        struct Entry
+        {
+            Entry(PathCacheKey const& key, dtPolyRef const* path, uint32 length) : m_key(key), m_path(path, path + length) {}
+
+            PathCacheKey m_key;
+            std::vector<dtPolyRef> m_path;
+            float m_minX, m_minY, m_maxX, m_maxY;           ///< world bounds of the polygons
+        };
+
+        typedef std::list<Entry> EntryList;                 // most recently used first
+        typedef UNORDERED_MAP<PathCacheKey, EntryList::iterator> EntryMap;
+
+        // drops the entries crossing the tiles changed since the last lookup
+        void CheckGeneration(MMAP::NavMeshQueryHolder const& mesh);
+        void DropArea(float minX, float minY, float maxX, float maxY);
+        void Clear();
+
+        uint32 m_capacity;
+        uint32 m_tileGeneration;
+
+        EntryList m_entries;
+        EntryMap m_entryMap;
+
+        Stats m_stats;
+
+        boost::mutex m_lock;
+};
+
+#endif
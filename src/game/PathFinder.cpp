@@ -20,6 +20,8 @@
 #include "GridMap.h"
 #include "Creature.h"
 #include "PathFinder.h"
+#include "MapManager.h"
+#include "PathCache.h"
 #include "Log.h"
 
 #include "detour/DetourCommon.h"
@@ -28,17 +30,14 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL)
+    m_sourceUnit(owner), m_mapId(owner->GetMapId()), m_navMesh(NULL), m_navMeshQuery(NULL), m_requestMap(NULL),
+    m_pathCache(NULL), m_meshHolder(NULL),
+    m_canSwim(false), m_canFly(false), m_startUnderWater(false), m_endUnderWater(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
-    uint32 mapId = m_sourceUnit->GetMapId();
-    if (MMAP::MMapFactory::IsPathfindingEnabled(mapId))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        m_navMesh = mmap->GetNavMesh(mapId);
-        m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
-    }
+    if (MMAP::MMapFactory::IsPathfindingEnabled(m_mapId))
+        m_navMesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(m_mapId);
 
     createFilter();
 }
@@ -46,9 +45,53 @@ PathFinder::PathFinder(const Unit* owner) :
 PathFinder::~PathFinder()
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+
+    if (m_requestMap)
+        m_requestMap->CancelPathRequest(this);
 }
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest)
+{
+    if (m_requestMap)
+    {
+        m_requestMap->CancelPathRequest(this);
+        m_requestMap = NULL;
+    }
+
+    if (prepare(destX, destY, destZ, forceDest))
+        buildPath();
+
+    return true;
+}
+
+void PathFinder::requestPath(float destX, float destY, float destZ, bool forceDest)
+{
+    if (!sMapMgr.GetPathUpdater() || !m_sourceUnit->IsInWorld())
+    {
+        calculate(destX, destY, destZ, forceDest);
+        return;
+    }
+
+    if (!prepare(destX, destY, destZ, forceDest))
+    {
+        // shortcut path is already set, a pending request would overwrite it
+        if (m_requestMap)
+        {
+            m_requestMap->CancelPathRequest(this);
+            m_requestMap = NULL;
+        }
+        return;
+    }
+
+    // a pending request just uses the new destination
+    if (!m_requestMap)
+    {
+        m_requestMap = m_sourceUnit->GetMap();
+        m_requestMap->QueuePathRequest(this);
+    }
+}
+
+bool PathFinder::prepare(float destX, float destY, float destZ, bool forceDest)
 {
     // Vector3 oldDest = getEndPosition();
     Vector3 dest(destX, destY, destZ);
@@ -64,21 +107,48 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
 
     // make sure navMesh works - we can run on map w/o mmap
-    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
-    if (!m_navMesh || !m_navMeshQuery || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING) ||
-            !HaveTile(start) || !HaveTile(dest))
+    if (!m_navMesh || m_sourceUnit->hasUnitState(UNIT_STAT_IGNORE_PATHFINDING))
     {
         BuildShortcut();
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
+        return false;
     }
 
     updateFilter();
 
-    BuildPolyPath(start, dest);
+    if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
+    {
+        m_canSwim = ((Creature*)m_sourceUnit)->CanSwim();
+        m_canFly = ((Creature*)m_sourceUnit)->CanFly();
+    }
+
+    m_startUnderWater = m_sourceUnit->GetTerrain()->IsUnderWater(start.x, start.y, start.z);
+    m_endUnderWater = m_sourceUnit->GetTerrain()->IsUnderWater(dest.x, dest.y, dest.z);
+
+    m_pathCache = &m_sourceUnit->GetMap()->GetPathCache();
     return true;
 }
 
+void PathFinder::buildPath()
+{
+    // the query keeps the tiles from being unloaded until the path is built
+    MMAP::NavMeshQueryHolder query(m_mapId);
+    m_navMeshQuery = query.GetQuery();
+    m_meshHolder = &query;
+
+    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
+    if (!m_navMeshQuery || !HaveTile(m_startPosition) || !HaveTile(m_endPosition))
+    {
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+    }
+    else
+        BuildPolyPath(m_startPosition, m_endPosition);
+
+    m_navMeshQuery = NULL;
+    m_meshHolder = NULL;
+}
+
 dtPolyRef PathFinder::getPathPolyByPosition(const dtPolyRef* polyPath, uint32 polyPathSize, const float* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -168,11 +238,11 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
         {
             // Check for swimming or flying shortcut
-            if ((startPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsUnderWater(startPos.x, startPos.y, startPos.z)) ||
-                    (endPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsUnderWater(endPos.x, endPos.y, endPos.z)))
-                m_type = ((Creature*)m_sourceUnit)->CanSwim() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+            if ((startPoly == INVALID_POLYREF && m_startUnderWater) ||
+                    (endPoly == INVALID_POLYREF && m_endUnderWater))
+                m_type = m_canSwim ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
             else
-                m_type = ((Creature*)m_sourceUnit)->CanFly() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+                m_type = m_canFly ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
         }
         else
             m_type = PATHFIND_NOPATH;
@@ -189,19 +259,17 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         bool buildShotrcut = false;
         if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
         {
-            Creature* owner = (Creature*)m_sourceUnit;
-
-            Vector3 p = (distToStartPoly > 7.0f) ? startPos : endPos;
-            if (m_sourceUnit->GetTerrain()->IsUnderWater(p.x, p.y, p.z))
+            bool underWater = (distToStartPoly > 7.0f) ? m_startUnderWater : m_endUnderWater;
+            if (underWater)
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: underWater case\n");
-                if (owner->CanSwim())
+                if (m_canSwim)
                     buildShotrcut = true;
             }
             else
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: flying case\n");
-                if (owner->CanFly())
+                if (m_canFly)
                     buildShotrcut = true;
             }
         }
@@ -323,14 +391,13 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         // generate suffix
         uint32 suffixPolyLength = 0;
-        dtStatus dtResult = m_navMeshQuery->findPath(
+        dtStatus dtResult = FindPolyPath(
                                 suffixStartPoly,    // start polygon
                                 endPoly,            // end polygon
                                 suffixEndPoint,     // start position
                                 endPoint,           // end position
-                                &m_filter,            // polygon search filter
                                 m_pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                                (int*)&suffixPolyLength,
+                                suffixPolyLength,
                                 MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
 
         if (!suffixPolyLength || dtResult != DT_SUCCESS)
@@ -357,14 +424,13 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtStatus dtResult = m_navMeshQuery->findPath(
+        dtStatus dtResult = FindPolyPath(
                                 startPoly,          // start polygon
                                 endPoly,            // end polygon
                                 startPoint,         // start position
                                 endPoint,           // end position
-                                &m_filter,           // polygon search filter
                                 m_pathPolyRefs,     // [out] path
-                                (int*)&m_polyLength,
+                                m_polyLength,
                                 MAX_PATH_LENGTH);   // max number of polygons in output path
 
         if (!m_polyLength || dtResult != DT_SUCCESS)
@@ -387,6 +453,25 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathFinder::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, const float* startPoint, const float* endPoint, dtPolyRef* path, uint32& length, uint32 maxLength)
+{
+    PathCacheKey key(startPoly, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags());
+
+    // units chasing or wandering between the same polygons get the same corridor
+    if (m_pathCache && m_pathCache->Find(key, *m_meshHolder, path, length, maxLength))
+    {
+        DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ FindPolyPath :: cached path of %u polys\n", length);
+        return DT_SUCCESS;
+    }
+
+    dtStatus dtResult = m_navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &m_filter, path, (int*)&length, maxLength);
+
+    if (m_pathCache && dtResult == DT_SUCCESS && length)
+        m_pathCache->Insert(key, *m_meshHolder, path, length);
+
+    return dtResult;
+}
+
 void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
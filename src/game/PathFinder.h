@@ -29,6 +29,13 @@ using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
+class Map;
+class PathCache;
+
+namespace MMAP
+{
+    class NavMeshQueryHolder;
+}
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -62,6 +69,15 @@ class PathFinder
         // return: true if new path was calculated, false otherwise (no change needed)
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
 
+        // Same as calculate(), but with mmap.pathThreads the path is calculated by the path workers
+        // at the end of the map update, isCalculating() tells when it is not ready yet
+        void requestPath(float destX, float destY, float destZ, bool forceDest = false);
+        bool isCalculating() const { return m_requestMap != NULL; }
+
+        // used by Map and MapPathUpdater to calculate the requested path, may run in a path worker
+        void buildPath();
+        void requestFinished() { m_requestMap = NULL; }
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); };
@@ -73,6 +89,7 @@ class PathFinder
 
         PointsArray& getPath() { return m_pathPoints; }
         PathType getPathType() const { return m_type; }
+        Unit const* getSourceUnit() const { return m_sourceUnit; }
 
     private:
 
@@ -91,8 +108,20 @@ class PathFinder
         Vector3        m_actualEndPosition;// {x, y, z} of the closest possible point to given destination
 
         const Unit* const       m_sourceUnit;       // the unit that is moving
+        uint32                  m_mapId;            // map of the nav mesh
         const dtNavMesh*        m_navMesh;          // the nav mesh
-        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path, only set in buildPath()
+
+        Map*                    m_requestMap;       // map the requested path is queued in, NULL if none is pending
+
+        PathCache*              m_pathCache;        // poly paths of the map of the unit, set by prepare()
+        const MMAP::NavMeshQueryHolder* m_meshHolder; // holder of m_navMeshQuery, only set in buildPath()
+
+        // state of the unit buildPath() needs, copied by prepare() as it may run in a path worker
+        bool                    m_canSwim;
+        bool                    m_canFly;
+        bool                    m_startUnderWater;
+        bool                    m_endUnderWater;
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -114,7 +143,10 @@ class PathFinder
         dtPolyRef getPolyByLocation(const float* point, float* distance) const;
         bool HaveTile(const Vector3& p) const;
 
+        bool prepare(float destX, float destY, float destZ, bool forceDest);
+
         void BuildPolyPath(const Vector3& startPos, const Vector3& endPos);
+        dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, const float* startPoint, const float* endPoint, dtPolyRef* path, uint32& length, uint32 maxLength);
         void BuildPointPath(const float* startPoint, const float* endPoint);
         void BuildShortcut();
 
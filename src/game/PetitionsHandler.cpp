@@ -228,6 +228,9 @@ void WorldSession::HandlePetitionBuyOpcode(WorldPacket& recv_data)
 
     DEBUG_LOG("Invalid petition GUIDs: %s", ssInvalidPetitionGUIDs.str().c_str());
     CharacterDatabase.escape_string(name);
+
+    // petitions are signed from the sessions of other accounts, their rows are written on the default async connection
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM petition WHERE petitionguid IN ( %s )",  ssInvalidPetitionGUIDs.str().c_str());
     CharacterDatabase.PExecute("DELETE FROM petition_sign WHERE petitionguid IN ( %s )", ssInvalidPetitionGUIDs.str().c_str());
@@ -433,6 +436,7 @@ void WorldSession::HandlePetitionRenameOpcode(WorldPacket& recv_data)
 
     std::string db_newname = newname;
     CharacterDatabase.escape_string(db_newname);
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
     CharacterDatabase.PExecute("UPDATE petition SET name = '%s' WHERE petitionguid = '%u'",
                                db_newname.c_str(), petitionGuid.GetCounter());
 
@@ -556,6 +560,7 @@ void WorldSession::HandlePetitionSignOpcode(WorldPacket& recv_data)
         return;
     }
 
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
     CharacterDatabase.PExecute("INSERT INTO petition_sign (ownerguid,petitionguid, playerguid, player_account) VALUES ('%u', '%u', '%u','%u')",
                                ownerLowGuid, petitionLowGuid, _player->GetGUIDLow(), GetAccountId());
 
@@ -889,6 +894,7 @@ void WorldSession::HandleTurnInPetitionOpcode(WorldPacket& recv_data)
 
     delete result;
 
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM petition WHERE petitionguid = '%u'", petitionGuid.GetCounter());
     CharacterDatabase.PExecute("DELETE FROM petition_sign WHERE petitionguid = '%u'", petitionGuid.GetCounter());
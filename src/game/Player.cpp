@@ -1449,7 +1449,8 @@ void Player::SetDeathState(DeathState s)
         GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_DEATH_IN_DUNGEON, 1);
 
         if (InstanceData* mapInstance = GetInstanceData())
-            mapInstance->OnPlayerDeath(this);
+            if (!GetMap()->DeferPlayerDeathHook(this))
+                mapInstance->OnPlayerDeath(this);
     }
 
     Unit::SetDeathState(s);
@@ -4102,6 +4103,9 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
  */
 void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
 {
+    // rows of the character are deleted in order with the requests of the account and the shared ones of the default async connection
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, accountId, 0);
+
     // for nonexistent account avoid update realm
     if (accountId == 0)
         updateRealmChars = false;
@@ -16715,6 +16719,8 @@ void Player::_LoadGroup(QueryResult* result)
 
 void Player::_LoadBoundInstances(QueryResult* result)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     for (uint8 i = 0; i < MAX_DIFFICULTY; ++i)
         m_boundInstances[i].clear();
 
@@ -16799,6 +16805,8 @@ void Player::UnbindInstance(uint32 mapid, Difficulty difficulty, bool unload)
 
 void Player::UnbindInstance(BoundInstancesMap::iterator& itr, Difficulty difficulty, bool unload)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     if (itr != m_boundInstances[difficulty].end())
     {
         if (!unload)
@@ -16814,6 +16822,9 @@ void Player::UnbindInstance(BoundInstancesMap::iterator& itr, Difficulty difficu
 
 InstancePlayerBind* Player::BindToInstance(DungeonPersistentState* state, bool permanent, bool load)
 {
+    // instance binds are written on the default async connection, in order with the instance resets
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     if (state)
     {
         InstancePlayerBind& bind = m_boundInstances[state->GetDifficulty()][state->GetMapId()];
@@ -16953,6 +16964,8 @@ void Player::SendSavedInstances()
 /// convert the player's binds to the group
 void Player::ConvertInstancesToGroup(Player* player, Group* group, ObjectGuid player_guid)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     bool has_binds = false;
     bool has_solo = false;
 
@@ -17070,6 +17083,9 @@ void Player::SaveToDB()
         return;
     }
 
+    // saves of the same account must not overtake each other or the loading at next login
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GetSession()->GetAccountId());
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -17967,6 +17983,9 @@ void Player::SendAttackSwingNotInRange()
 
 void Player::SavePositionInDB(ObjectGuid guid, uint32 mapid, float x, float y, float z, float o, uint32 zone)
 {
+    // used for offline characters too, in order with the requests of the account
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, sObjectMgr.GetPlayerAccountIdByGUID(guid));
+
     std::ostringstream ss;
     ss << "UPDATE characters SET position_x='" << x << "',position_y='" << y
        << "',position_z='" << z << "',orientation='" << o << "',map='" << mapid
@@ -18508,6 +18527,9 @@ void Player::SendProficiency(ItemClass itemClass, uint32 itemSubclassMask)
 
 void Player::RemovePetitionsAndSigns(ObjectGuid guid, uint32 type)
 {
+    // petition rows are written on the default async connection, see WorldSession::HandlePetitionBuyOpcode
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, 0);
+
     uint32 lowguid = guid.GetCounter();
 
     QueryResult* result = NULL;
@@ -19819,13 +19841,13 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
 }
 
 template<class T>
-inline void UpdateVisibilityOf_helper(GuidSet& s64, T* target)
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, T* target)
 {
     s64.insert(target->GetObjectGuid());
 }
 
 template<>
-inline void UpdateVisibilityOf_helper(GuidSet& s64, GameObject* target)
+inline void UpdateVisibilityOf_helper(ClientGuidSet& s64, GameObject* target)
 {
     if (!target->IsTransport())
         s64.insert(target->GetObjectGuid());
@@ -20557,16 +20579,18 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata;
     WorldPacket packet;
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
-        if (itr->IsGameObject())
+        ObjectGuid guid = itr->first;
+
+        if (guid.IsGameObject())
         {
-            if (GameObject* obj = GetMap()->GetGameObject(*itr))
+            if (GameObject* obj = GetMap()->GetGameObject(guid))
                 obj->BuildValuesUpdateBlockForPlayer(&udata, this);
         }
-        else if (itr->IsCreatureOrVehicle())
+        else if (guid.IsCreatureOrVehicle())
         {
-            Creature* obj = GetMap()->GetAnyTypeCreature(*itr);
+            Creature* obj = GetMap()->GetAnyTypeCreature(guid);
             if (!obj)
                 continue;
 
@@ -20853,6 +20877,20 @@ void Player::RewardSinglePlayerAtKill(Unit* pVictim)
     }
 }
 
+void Player::InformPvPDeathHooks(Player* killer, bool selfKill)
+{
+    if (BattleGround* bg = GetBattleGround())
+    {
+        bg->HandleKillPlayer(this, killer);
+    }
+    else if (!selfKill)
+    {
+        // selfkills are not handled in outdoor pvp scripts
+        if (OutdoorPvP* outdoorPvP = sOutdoorPvPMgr.GetScript(GetCachedZoneId()))
+            outdoorPvP->HandlePlayerKill(killer, this);
+    }
+}
+
 void Player::RewardPlayerAndGroupAtEvent(uint32 creature_id, WorldObject* pRewardSource)
 {
     MANGOS_ASSERT((!GetGroup() || pRewardSource) && "Player::RewardPlayerAndGroupAtEvent called for Group-Case but no source for range searching provided");
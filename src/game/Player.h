@@ -988,6 +988,53 @@ class TradeData
         ObjectGuid m_items[TRADE_SLOT_COUNT];               // traded itmes from m_player side including non-traded slot
 };
 
+/**
+ * Objects created at the client of a player.
+ *
+ * Each guid keeps the number of the last visibility sweep (VisibleNotifier) that visited it, so at the
+ * end of a sweep the known objects it did not reach are found without copying the whole set first.
+ */
+class ClientGuidSet
+{
+    public:
+        typedef UNORDERED_MAP<ObjectGuid, uint32> StorageType;
+        typedef StorageType::const_iterator const_iterator;
+
+        ClientGuidSet() : m_sweep(0) {}
+
+        bool contains(ObjectGuid guid) const { return m_guids.find(guid) != m_guids.end(); }
+        void insert(ObjectGuid guid) { m_guids[guid] = m_sweep; }
+        void erase(ObjectGuid guid) { m_guids.erase(guid); }
+        bool empty() const { return m_guids.empty(); }
+
+        const_iterator begin() const { return m_guids.begin(); }
+        const_iterator end() const { return m_guids.end(); }
+
+        // visibility sweep support, objects inserted during a sweep count as visited
+        void BeginSweep() { ++m_sweep; }
+        void MarkVisited(ObjectGuid guid)
+        {
+            StorageType::iterator itr = m_guids.find(guid);
+            if (itr != m_guids.end())
+                itr->second = m_sweep;
+        }
+        bool IsVisited(ObjectGuid guid) const
+        {
+            const_iterator itr = m_guids.find(guid);
+            return itr == m_guids.end() || itr->second == m_sweep;
+        }
+        void GetNotVisited(GuidSet& guids) const
+        {
+            for (const_iterator itr = m_guids.begin(); itr != m_guids.end(); ++itr)
+                if (itr->second != m_sweep)
+                    guids.insert(itr->first);
+        }
+
+    private:
+        StorageType m_guids;
+        uint32 m_sweep;
+};
+
 class MANGOS_DLL_SPEC Player : public Unit
 {
         friend class WorldSession;
@@ -1899,6 +1946,7 @@ class MANGOS_DLL_SPEC Player : public Unit
 
         bool IsAtGroupRewardDistance(WorldObject const* pRewardSource) const;
         void RewardSinglePlayerAtKill(Unit* pVictim);
+        void InformPvPDeathHooks(Player* killer, bool selfKill);
         void RewardPlayerAndGroupAtEvent(uint32 creature_id, WorldObject* pRewardSource);
         void RewardPlayerAndGroupAtCast(WorldObject* pRewardSource, uint32 spellid = 0);
         bool isHonorOrXPTarget(Unit* pVictim) const;
@@ -2194,9 +2242,9 @@ class MANGOS_DLL_SPEC Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // currently visible objects at player client
-        GuidSet m_clientGUIDs;
+        ClientGuidSet m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.contains(u->GetObjectGuid()); }
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* pl) const;
@@ -615,14 +615,15 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count);                                  // placeholder
 
-    for (GuidSet::const_iterator itr = _player->m_clientGUIDs.begin(); itr != _player->m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = _player->m_clientGUIDs.begin(); itr != _player->m_clientGUIDs.end(); ++itr)
     {
+        ObjectGuid guid = itr->first;
         uint8 dialogStatus = DIALOG_STATUS_NONE;
 
-        if (itr->IsAnyTypeCreature())
+        if (guid.IsAnyTypeCreature())
         {
             // need also pet quests case support
-            Creature* questgiver = GetPlayer()->GetMap()->GetAnyTypeCreature(*itr);
+            Creature* questgiver = GetPlayer()->GetMap()->GetAnyTypeCreature(guid);
 
             if (!questgiver || questgiver->IsHostileTo(_player))
                 continue;
@@ -639,9 +640,9 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
             data << uint8(dialogStatus);
             ++count;
         }
-        else if (itr->IsGameObject())
+        else if (guid.IsGameObject())
         {
-            GameObject* questgiver = GetPlayer()->GetMap()->GetGameObject(*itr);
+            GameObject* questgiver = GetPlayer()->GetMap()->GetGameObject(guid);
 
             if (!questgiver)
                 continue;
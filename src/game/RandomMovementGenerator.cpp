@@ -21,6 +21,7 @@
 #include "RandomMovementGenerator.h"
 #include "Map.h"
 #include "Util.h"
+#include "PathFinder.h"
 #include "movement/MoveSplineInit.h"
 #include "movement/MoveSpline.h"
 
@@ -36,23 +37,21 @@ RandomMovementGenerator<Creature>::RandomMovementGenerator(const Creature& creat
     i_radius = wander_distance;
     // TODO - add support for flying mobs using some distance
     i_verticalZ = 0.0f;
+    i_path = NULL;
+    i_pathPending = false;
 }
 
 template<>
-void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
+RandomMovementGenerator<Creature>::~RandomMovementGenerator()
 {
-    const float angle = rand_norm_f() * (M_PI_F * 2.0f);
-    const float range = rand_norm_f() * i_radius;
-
-    float destX = i_x + range * cos(angle);
-    float destY = i_y + range * sin(angle);
-    float destZ = i_z + frand(-1, 1) * i_verticalZ;
-    creature.UpdateAllowedPositionZ(destX, destY, destZ);
-
-    creature.addUnitState(UNIT_STAT_ROAMING_MOVE);
+    delete i_path;
+}
 
+template<>
+void RandomMovementGenerator<Creature>::_moveByPath(Creature& creature)
+{
     Movement::MoveSplineInit init(creature);
-    init.MoveTo(destX, destY, destZ, true);
+    init.MovebyPath(i_path->getPath());
     init.SetWalk(true);
     init.Launch();
 
@@ -67,6 +66,30 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
     }
 }
 
+template<>
+void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
+{
+    const float angle = rand_norm_f() * (M_PI_F * 2.0f);
+    const float range = rand_norm_f() * i_radius;
+
+    float destX = i_x + range * cos(angle);
+    float destY = i_y + range * sin(angle);
+    float destZ = i_z + frand(-1, 1) * i_verticalZ;
+    creature.UpdateAllowedPositionZ(destX, destY, destZ);
+
+    creature.addUnitState(UNIT_STAT_ROAMING_MOVE);
+
+    if (!i_path)
+        i_path = new PathFinder(&creature);
+
+    i_path->requestPath(destX, destY, destZ);
+
+    // launched by Update() once the path workers calculated it
+    i_pathPending = i_path->isCalculating();
+    if (!i_pathPending)
+        _moveByPath(creature);
+}
+
 template<>
 void RandomMovementGenerator<Creature>::Initialize(Creature& creature)
 {
@@ -105,10 +128,21 @@ bool RandomMovementGenerator<Creature>::Update(Creature& creature, const uint32&
     if (creature.hasUnitState(UNIT_STAT_NOT_MOVE))
     {
         i_nextMoveTime.Reset(0);  // Expire the timer
+        i_pathPending = false;
         creature.clearUnitState(UNIT_STAT_ROAMING_MOVE);
         return true;
     }
 
+    if (i_pathPending)
+    {
+        if (!i_path->isCalculating())
+        {
+            i_pathPending = false;
+            _moveByPath(creature);
+        }
+        return true;
+    }
+
     if (creature.movespline->Finalized())
     {
         i_nextMoveTime.Update(diff);
@@ -21,6 +21,8 @@
 
 #include "MovementGenerator.h"
 
+class PathFinder;
+
 // define chance for creature to not stop after reaching a waypoint
 #define MOVEMENT_RANDOM_MMGEN_CHANCE_NO_BREAK 30
 
@@ -31,9 +33,11 @@ class MANGOS_DLL_SPEC RandomMovementGenerator
     public:
         explicit RandomMovementGenerator(const Creature&);
         explicit RandomMovementGenerator(float x, float y, float z, float radius, float verticalZ = 0.0f) :
-            i_nextMoveTime(0), i_x(x), i_y(y), i_z(z), i_radius(radius), i_verticalZ(verticalZ) {}
+            i_nextMoveTime(0), i_x(x), i_y(y), i_z(z), i_radius(radius), i_verticalZ(verticalZ), i_path(NULL), i_pathPending(false) {}
+        ~RandomMovementGenerator();
 
         void _setRandomLocation(T&);
+        void _moveByPath(T&);
         void Initialize(T&);
         void Finalize(T&);
         void Interrupt(T&);
@@ -45,6 +49,8 @@ class MANGOS_DLL_SPEC RandomMovementGenerator
         float i_x, i_y, i_z;
         float i_radius;
         float i_verticalZ;
+        PathFinder* i_path;
+        bool i_pathPending;                                 ///< requested path not launched yet
 };
 
 #endif
@@ -48,6 +48,8 @@
 #include "TemporarySummon.h"
 #include "SQLStorages.h"
 
+#include <boost/scoped_array.hpp>
+
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
 class PrioritizeManaUnitWraper
@@ -687,7 +689,7 @@ void Spell::FillTargetMap()
 
         for (UnitList::iterator itr = tmpUnitLists[effToIndex[i]].begin(); itr != tmpUnitLists[effToIndex[i]].end();)
         {
-            if (!CheckTarget(*itr, SpellEffectIndex(i)))
+            if (!CheckTarget(*itr, SpellEffectIndex(i), false))
             {
                 itr = tmpUnitLists[effToIndex[i]].erase(itr);
                 continue;
@@ -696,6 +698,8 @@ void Spell::FillTargetMap()
                 ++itr;
         }
 
+        FilterTargetsInLOS(tmpUnitLists[effToIndex[i]], SpellEffectIndex(i));
+
         for (UnitList::const_iterator iunit = tmpUnitLists[effToIndex[i]].begin(); iunit != tmpUnitLists[effToIndex[i]].end(); ++iunit)
             AddUnitTarget((*iunit), SpellEffectIndex(i));
     }
@@ -1142,7 +1146,10 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
         if (m_spellInfo->SpellFamilyName == SPELLFAMILY_WARLOCK && m_spellInfo->SpellIconID == 3172 &&
                 (m_spellInfo->SpellFamilyFlags & UI64LIT(0x0004000000000000)))
             if (Aura* dummy = unitTarget->GetDummyAura(m_spellInfo->Id))
+            {
                 dummy->GetModifier()->m_amount = damageInfo.damage;
+                unitTarget->InvalidateAuraTotals(SPELL_AURA_DUMMY);
+            }
 
         caster->DealSpellDamage(&damageInfo, true);
 
@@ -7066,7 +7073,7 @@ CurrentSpellTypes Spell::GetCurrentContainer()
         return (CURRENT_GENERIC_SPELL);
 }
 
-bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
+bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool checkLOS /*= true*/)
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
     if (m_spellInfo->EffectImplicitTargetA[eff] != TARGET_SELF)
@@ -7143,7 +7150,7 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
             break;
         default:                                            // normal case
             // Get GO cast coordinates if original caster -> GO
-            if (target != m_caster)
+            if (checkLOS && target != m_caster)
                 if (WorldObject* caster = GetCastingObject())
                     if (!m_spellInfo->HasAttribute(SPELL_ATTR_EX2_IGNORE_LOS) && !target->IsWithinLOSInMap(caster))
                         return false;
@@ -7172,6 +7179,64 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
     return true;
 }
 
+void Spell::FilterTargetsInLOS(UnitList& targetUnitMap, SpellEffectIndex eff)
+{
+    // effects with own or without line of sight checks, see CheckTarget
+    switch (m_spellInfo->Effect[eff])
+    {
+        case SPELL_EFFECT_SUMMON_PLAYER:
+        case SPELL_EFFECT_DUMMY:
+        case SPELL_EFFECT_RESURRECT_NEW:
+            return;
+        default:
+            break;
+    }
+
+    if (m_spellInfo->HasAttribute(SPELL_ATTR_EX2_IGNORE_LOS))
+        return;
+
+    WorldObject* caster = GetCastingObject();
+    if (!caster)
+        return;
+
+    // the rays of all targets start at the caster, so AoE target lists are tested in one batch
+    std::vector<float> destX, destY, destZ;
+    destX.reserve(targetUnitMap.size());
+    destY.reserve(targetUnitMap.size());
+    destZ.reserve(targetUnitMap.size());
+
+    for (UnitList::iterator itr = targetUnitMap.begin(); itr != targetUnitMap.end();)
+    {
+        if (*itr == m_caster)
+            ++itr;
+        else if (!(*itr)->IsInMap(caster))
+            itr = targetUnitMap.erase(itr);
+        else
+        {
+            destX.push_back((*itr)->GetPositionX());
+            destY.push_back((*itr)->GetPositionY());
+            destZ.push_back((*itr)->GetPositionZ() + 2.0f);
+            ++itr;
+        }
+    }
+
+    if (destX.empty())
+        return;
+
+    boost::scoped_array<bool> inLOS(new bool[destX.size()]);
+    caster->GetMap()->IsInLineOfSight(caster->GetPositionX(), caster->GetPositionY(), caster->GetPositionZ() + 2.0f,
+                                      &destX[0], &destY[0], &destZ[0], inLOS.get(), destX.size(), caster->GetPhaseMask());
+
+    size_t idx = 0;
+    for (UnitList::iterator itr = targetUnitMap.begin(); itr != targetUnitMap.end();)
+    {
+        if (*itr != m_caster && !inLOS[idx++])
+            itr = targetUnitMap.erase(itr);
+        else
+            ++itr;
+    }
+}
+
 bool Spell::IsNeedSendToClient() const
 {
     return m_spellInfo->SpellVisual[0] || m_spellInfo->SpellVisual[1] || IsChanneledSpell(m_spellInfo) ||
@@ -858,7 +858,12 @@ void Aura::ApplyModifier(bool apply, bool Real)
     GetHolder()->SetInUse(true);
     SetInUse(true);
     if (aura < TOTAL_AURAS)
+    {
+        // handlers can change the amount before and after recalculating the totals
+        GetTarget()->InvalidateAuraTotals(aura);
         (*this.*AuraHandler [aura])(apply, Real);
+        GetTarget()->InvalidateAuraTotals(aura);
+    }
     SetInUse(false);
     GetHolder()->SetInUse(false);
 }
@@ -1212,10 +1217,12 @@ void Aura::TriggerSpell()
                         if (target->GetTypeId() != TYPEID_UNIT)
                             return;
 
-                        ThreatList const& tList = target->getThreatManager().getThreatList();
-                        for (ThreatList::const_iterator itr = tList.begin(); itr != tList.end(); ++itr)
+                        // threat changes can add refs to the list, iterate a copy
+                        GuidVector guids;
+                        ((Creature*)target)->FillGuidsListFromThreatList(guids);
+                        for (GuidVector::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
                         {
-                            Unit* pUnit = target->GetMap()->GetUnit((*itr)->getUnitGuid());
+                            Unit* pUnit = target->GetMap()->GetUnit(*itr);
 
                             if (pUnit && target->getThreatManager().getThreat(pUnit))
                                 target->getThreatManager().modifyThreatPercent(pUnit, -100);
@@ -1762,10 +1769,15 @@ void Aura::TriggerSpell()
                     case 69012:                             // Explosive Barrage
                     {
                         // Summon an Exploding Orb for each player in combat with the caster
-                        ThreatList const& threatList = target->getThreatManager().getThreatList();
-                        for (ThreatList::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                        if (target->GetTypeId() != TYPEID_UNIT)
+                            return;
+
+                        // casts can add refs to the threat list, iterate a copy
+                        GuidVector guids;
+                        ((Creature*)target)->FillGuidsListFromThreatList(guids);
+                        for (GuidVector::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
                         {
-                            if (Unit* expectedTarget = target->GetMap()->GetUnit((*itr)->getUnitGuid()))
+                            if (Unit* expectedTarget = target->GetMap()->GetUnit(*itr))
                             {
                                 if (expectedTarget->GetTypeId() == TYPEID_PLAYER)
                                     target->CastSpell(expectedTarget, 69015, true);
@@ -8346,6 +8358,7 @@ void Aura::PeriodicDummyTick()
                 if (Aura* aura = GetHolder()->GetAuraByEffectIndex(SpellEffectIndex(GetEffIndex() - 1)))
                 {
                     aura->GetModifier()->m_amount = m_modifier.m_amount;
+                    target->InvalidateAuraTotals(SPELL_AURA_MOD_POWER_REGEN);
                     ((Player*)target)->UpdateManaRegen();
                     // Disable continue
                     m_isPeriodic = false;
@@ -77,7 +77,17 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool up
     // allow pets following their master to cheat while generating paths
     bool forceDest = (owner.GetTypeId() == TYPEID_UNIT && ((Creature*)&owner)->IsPet()
                       && owner.hasUnitState(UNIT_STAT_FOLLOW));
-    i_path->calculate(x, y, z, forceDest);
+    i_path->requestPath(x, y, z, forceDest);
+
+    // launched by Update() once the path workers calculated it
+    m_pathPending = i_path->isCalculating();
+    if (!m_pathPending)
+        _moveByPath(owner);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_moveByPath(T& owner)
+{
     if (i_path->getPathType() & PATHFIND_NOPATH)
         return;
 
@@ -127,6 +137,12 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
         return true;
     }
 
+    if (m_pathPending && !i_path->isCalculating())
+    {
+        m_pathPending = false;
+        _moveByPath(owner);
+    }
+
     bool targetMoved = false;
     i_recheckDistance.Update(time_diff);
     if (i_recheckDistance.Passed())
@@ -139,7 +155,7 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
     if (m_speedChanged || targetMoved)
         _setTargetLocation(owner, targetMoved);
 
-    if (owner.movespline->Finalized())
+    if (owner.movespline->Finalized() && !m_pathPending)
     {
         if (i_angle == 0.f && !owner.HasInArc(0.01f, i_target.getTarget()))
             owner.SetInFront(i_target.getTarget());
@@ -42,7 +42,7 @@ class MANGOS_DLL_SPEC TargetedMovementGeneratorMedium
             TargetedMovementGeneratorBase(target),
             i_recheckDistance(0),
             i_offset(offset), i_angle(angle),
-            m_speedChanged(false), i_targetReached(false),
+            m_speedChanged(false), i_targetReached(false), m_pathPending(false),
             i_path(NULL)
         {
         }
@@ -59,6 +59,7 @@ class MANGOS_DLL_SPEC TargetedMovementGeneratorMedium
 
     protected:
         void _setTargetLocation(T&, bool updateDestination);
+        void _moveByPath(T&);
         bool RequiresNewPosition(T& owner, float x, float y, float z) const;
         virtual float GetDynamicTargetDistance(T& /*owner*/, bool /*forRangeCheck*/) const { return i_offset; }
 
@@ -67,6 +68,7 @@ class MANGOS_DLL_SPEC TargetedMovementGeneratorMedium
         float i_angle;
         bool m_speedChanged : 1;
         bool i_targetReached : 1;
+        bool m_pathPending : 1;                             ///< requested path not launched yet
 
         PathFinder* i_path;
 };
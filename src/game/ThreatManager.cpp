@@ -25,6 +25,8 @@
 #include "ObjectAccessor.h"
 #include "UnitEvents.h"
 
+#include <algorithm>
+
 //==============================================================
 //================= ThreatCalcHelper ===========================
 //==============================================================
@@ -217,6 +219,15 @@ void ThreatContainer::clearReferences()
     iThreatList.clear();
 }
 
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    ThreatList::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), pRef);
+    if (itr != iThreatList.end())
+        iThreatList.erase(itr);
+}
+
 //============================================================
 // Return the HostileReference of NULL, if not found
 HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
@@ -266,7 +277,7 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
+    // ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
     return lhs->getThreat() > rhs->getThreat();             // reverse sorting
 }
 
@@ -277,7 +288,18 @@ void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        // between two updates only few refs change their place, an insertion sort
+        // of the almost sorted list is linear, stable and doesn't allocate
+        for (size_t i = 1; i < iThreatList.size(); ++i)
+        {
+            HostileReference* ref = iThreatList[i];
+
+            size_t j = i;
+            for (; j > 0 && HostileReferenceSortPredicate(ref, iThreatList[j - 1]); --j)
+                iThreatList[j] = iThreatList[j - 1];
+
+            iThreatList[j] = ref;
+        }
     }
     iDirty = false;
 }
@@ -25,7 +25,7 @@
 #include "UnitEvents.h"
 #include "Timer.h"
 #include "ObjectGuid.h"
-#include <list>
+#include <vector>
 
 //==============================================================
 
@@ -134,7 +134,8 @@ class MANGOS_DLL_SPEC HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// sorted by threat, highest first, contiguous as it is searched on every threat change
+typedef std::vector<HostileReference*> ThreatList;
 
 class MANGOS_DLL_SPEC ThreatContainer
 {
@@ -144,7 +145,7 @@ class MANGOS_DLL_SPEC ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
+        void remove(HostileReference* pRef);
         void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
         void clearReferences();
         // Sort the list if necessary
@@ -58,15 +58,22 @@ bool Totem::Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo const*
     if (!cPos.Relocate(this))
         return false;
 
+    // Notify the map's instance data, after a concurrent cell phase if in one
+    if (!GetMap()->DeferCreateHooks(this))
+        InformCreateHooks();
+
+    LoadCreatureAddon(false);
+
+    return true;
+}
+
+void Totem::InformCreateHooks()
+{
     // Notify the map's instance data.
     // Only works if you create the object in it, not if it is moves to that map.
     // Normally non-players do not teleport to other maps.
     if (InstanceData* iData = GetMap()->GetInstanceData())
         iData->OnCreatureCreate(this);
-
-    LoadCreatureAddon(false);
-
-    return true;
 }
 
 void Totem::Update(uint32 update_diff, uint32 time)
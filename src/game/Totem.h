@@ -34,6 +34,7 @@ class Totem : public Creature
         explicit Totem();
         virtual ~Totem() {};
         bool Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo const* cinfo, Unit* owner);
+        void InformCreateHooks() override;
         void Update(uint32 update_diff, uint32 time) override;
         void Summon(Unit* owner);
         void UnSummon();
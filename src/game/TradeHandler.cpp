@@ -480,6 +480,8 @@ void WorldSession::HandleAcceptTradeOpcode(WorldPacket& recvPacket)
         trader->m_trade = NULL;
 
         // desynchronized with the other saves here (SaveInventoryAndGoldToDB() not have own transaction guards)
+        // items change hands between both accounts
+        Database::AsyncKeyGuard asyncKey(CharacterDatabase, GetAccountId(), trader->GetSession()->GetAccountId());
         CharacterDatabase.BeginTransaction();
         _player->SaveInventoryAndGoldToDB();
         trader->SaveInventoryAndGoldToDB();
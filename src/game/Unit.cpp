@@ -183,6 +183,8 @@ void GlobalCooldownMgr::CancelGlobalCooldown(SpellEntry const* spellInfo)
 ////////////////////////////////////////////////////////////
 // Methods of class Unit
 
+Unit::AuraList const Unit::s_emptyAuraList;
+
 Unit::Unit() :
     movespline(new Movement::MoveSpline()),
     m_charmInfo(NULL),
@@ -194,6 +196,8 @@ Unit::Unit() :
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
 
+    memset(m_modAuraIndex, 0, sizeof(m_modAuraIndex));
+
     m_updateFlag = (UPDATEFLAG_HIGHGUID | UPDATEFLAG_LIVING | UPDATEFLAG_HAS_POSITION);
 
     m_attackTimer[BASE_ATTACK]   = 0;
@@ -288,6 +292,9 @@ Unit::~Unit()
     delete m_vehicleInfo;
     delete movespline;
 
+    for (std::vector<ModAuraBucket*>::const_iterator itr = m_modAuraBuckets.begin(); itr != m_modAuraBuckets.end(); ++itr)
+        delete *itr;
+
     // those should be already removed at "RemoveFromWorld()" call
     MANGOS_ASSERT(m_gameObj.size() == 0);
     MANGOS_ASSERT(m_dynObjGUIDs.size() == 0);
@@ -507,16 +514,18 @@ bool Unit::CanReachWithMeleeAttack(Unit const* pVictim, float flat_mod /*= 0.0f*
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = GetAurasByType(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         RemoveAurasDueToSpell((*iter)->GetId());
-        iter = m_modAuras[auraType].begin();
+        iter = auras.begin();
     }
 }
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType, SpellAuraHolder* except)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = GetAurasByType(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         // skip `except` aura
         if ((*iter)->GetHolder() == except)
@@ -526,18 +535,19 @@ void Unit::RemoveSpellsCausingAura(AuraType auraType, SpellAuraHolder* except)
         }
 
         RemoveAurasDueToSpell((*iter)->GetId(), except);
-        iter = m_modAuras[auraType].begin();
+        iter = auras.begin();
     }
 }
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType, ObjectGuid casterGuid)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = GetAurasByType(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         if ((*iter)->GetCasterGuid() == casterGuid)
         {
             RemoveSpellAuraHolder((*iter)->GetHolder());
-            iter = m_modAuras[auraType].begin();
+            iter = auras.begin();
         }
         else
             ++iter;
@@ -764,8 +774,8 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
             player_tap->SendDirectMessage(&data);
         }
 
-        // Reward player, his pets, and group/raid members
-        if (player_tap != pVictim)
+        // Reward player, his pets, and group/raid members, after a concurrent cell phase if in one
+        if (player_tap != pVictim && !GetMap()->DeferKillReward(pVictim, player_tap, group_tap))
         {
             if (group_tap)
                 group_tap->RewardGroupAtKill(pVictim, player_tap);
@@ -857,19 +867,9 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
                 playerVictim->DuelComplete(DUEL_INTERRUPTED);
             }
 
-            if (player_tap)                                 // PvP kill
-            {
-                if (BattleGround* bg = playerVictim->GetBattleGround())
-                {
-                    bg->HandleKillPlayer(playerVictim, player_tap);
-                }
-                else if (pVictim != this)
-                {
-                    // selfkills are not handled in outdoor pvp scripts
-                    if (OutdoorPvP* outdoorPvP = sOutdoorPvPMgr.GetScript(playerVictim->GetCachedZoneId()))
-                        outdoorPvP->HandlePlayerKill(player_tap, playerVictim);
-                }
-            }
+            // PvP kill, the battleground or outdoor pvp script is informed after a concurrent cell phase if in one
+            if (player_tap && !GetMap()->DeferPvPDeathHooks(playerVictim, player_tap, pVictim == this))
+                playerVictim->InformPvPDeathHooks(player_tap, pVictim == this);
         }
         else                                                // Killed creature
             JustKilledCreature((Creature*)pVictim, player_tap);
@@ -1060,7 +1060,29 @@ void Unit::JustKilledCreature(Creature* victim, Player* responsiblePlayer)
             ((Creature*)pOwner)->AI()->SummonedCreatureJustDied(victim);
     }
 
-    // Inform Instance Data and Linking
+    // Inform Instance Data, Linking and the zone scripts, after a concurrent cell phase if in one
+    if (!GetMap()->DeferDeathHooks(this, victim, responsiblePlayer))
+        InformCreatureDeathHooks(victim, responsiblePlayer);
+
+    bool isPet = victim->IsPet();
+
+    /* ********************************* Set Death finally ************************************* */
+    DEBUG_FILTER_LOG(LOG_FILTER_DAMAGE, "SET JUST_DIED");
+    victim->SetDeathState(JUST_DIED);                       // if !spiritOfRedemtionTalentReady always true for unit
+
+    if (isPet)
+        return;                                             // Pets might have been unsummoned at this place, do not handle them further!
+
+    /* ******************************** Prepare loot if can ************************************ */
+    victim->DeleteThreatList();
+    // only lootable if it has loot or can drop gold
+    victim->PrepareBodyLootState();
+    // may have no loot, so update death timer if allowed, must be after SetDeathState(JUST_DIED)
+    victim->AllLootRemovedFromCorpse();
+}
+
+void Unit::InformCreatureDeathHooks(Creature* victim, Player* responsiblePlayer)
+{
     if (InstanceData* mapInstance = victim->GetInstanceData())
         mapInstance->OnCreatureDeath(victim);
 
@@ -1105,22 +1127,6 @@ void Unit::JustKilledCreature(Creature* victim, Player* responsiblePlayer)
             ((DungeonMap*)m)->GetPersistanceState()->UpdateEncounterState(ENCOUNTER_CREDIT_KILL_CREATURE, victim->GetEntry());
         }
     }
-
-    bool isPet = victim->IsPet();
-
-    /* ********************************* Set Death finally ************************************* */
-    DEBUG_FILTER_LOG(LOG_FILTER_DAMAGE, "SET JUST_DIED");
-    victim->SetDeathState(JUST_DIED);                       // if !spiritOfRedemtionTalentReady always true for unit
-
-    if (isPet)
-        return;                                             // Pets might have been unsummoned at this place, do not handle them further!
-
-    /* ******************************** Prepare loot if can ************************************ */
-    victim->DeleteThreatList();
-    // only lootable if it has loot or can drop gold
-    victim->PrepareBodyLootState();
-    // may have no loot, so update death timer if allowed, must be after SetDeathState(JUST_DIED)
-    victim->AllLootRemovedFromCorpse();
 }
 
 void Unit::PetOwnerKilledUnit(Unit* pVictim)
@@ -2283,6 +2289,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         mod->m_amount -= currentAbsorb;
         if ((*i)->GetHolder()->DropAuraCharge())
             mod->m_amount = 0;
+        InvalidateAuraTotals(SPELL_AURA_SCHOOL_ABSORB);
         // Need remove it later
         if (mod->m_amount <= 0)
             existExpired = true;
@@ -2345,6 +2352,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
             incanterAbsorption += currentAbsorb;
 
         (*i)->GetModifier()->m_amount -= currentAbsorb;
+        InvalidateAuraTotals(SPELL_AURA_MANA_SHIELD);
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -2546,6 +2554,7 @@ void Unit::CalculateHealAbsorb(const uint32 heal, uint32* absorb)
         mod->m_amount -= currentAbsorb;
         if ((*i)->GetHolder()->DropAuraCharge())
             mod->m_amount = 0;
+        InvalidateAuraTotals(SPELL_AURA_HEAL_ABSORB);
         // Need remove it later
         if (mod->m_amount <= 0)
             existExpired = true;
@@ -3829,26 +3838,37 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+Unit::ModAuraBucket const* Unit::GetModAuraTotals(AuraType type) const
 {
+    ModAuraBucket* bucket = GetModAuraBucket(type);
+    if (!bucket || bucket->m_totalsValid)
+        return bucket;
+
     int32 modifier = 0;
+    float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    for (AuraList::const_iterator i = bucket->m_auras.begin(); i != bucket->m_auras.end(); ++i)
+    {
         modifier += (*i)->GetModifier()->m_amount;
+        multiplier *= (100.0f + (*i)->GetModifier()->m_amount) / 100.0f;
+    }
 
-    return modifier;
+    bucket->m_totalModifier = modifier;
+    bucket->m_totalMultiplier = multiplier;
+    bucket->m_totalsValid = true;
+    return bucket;
 }
 
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        multiplier *= (100.0f + (*i)->GetModifier()->m_amount) / 100.0f;
+    ModAuraBucket const* bucket = GetModAuraTotals(auratype);
+    return bucket ? bucket->m_totalModifier : 0;
+}
 
-    return multiplier;
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+{
+    ModAuraBucket const* bucket = GetModAuraTotals(auratype);
+    return bucket ? bucket->m_totalMultiplier : 1.0f;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
@@ -4255,7 +4275,20 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
-        m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        GetModAuraList(aura->GetModifier()->m_auraname).push_back(aura);
+}
+
+Unit::AuraList& Unit::GetModAuraList(AuraType type)
+{
+    if (!m_modAuraIndex[type])
+    {
+        m_modAuraBuckets.push_back(new ModAuraBucket);
+        m_modAuraIndex[type] = uint16(m_modAuraBuckets.size());
+    }
+
+    ModAuraBucket* bucket = m_modAuraBuckets[m_modAuraIndex[type] - 1];
+    bucket->m_totalsValid = false;
+    return bucket->m_auras;
 }
 
 void Unit::RemoveRankAurasDueToSpell(uint32 spellId)
@@ -4893,7 +4926,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     // remove from list before mods removing (prevent cyclic calls, mods added before including to aura list - use reverse order)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
-        m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        GetModAuraList(Aur->GetModifier()->m_auraname).remove(Aur);
     }
 
     // Set remove mode
@@ -8041,7 +8074,8 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
             pCreature->SetInCombatWithZone();
 
         if (InstanceData* mapInstance = GetInstanceData())
-            mapInstance->OnCreatureEnterCombat(pCreature);
+            if (!GetMap()->DeferCombatHook(pCreature, false))
+                mapInstance->OnCreatureEnterCombat(pCreature);
 
         if (m_isCreatureLinkingTrigger)
             GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_AGGRO, pCreature, enemy);
@@ -8363,10 +8397,12 @@ void Unit::UpdateVisibilityAndView()
     static const AuraType auratypes[] = {SPELL_AURA_BIND_SIGHT, SPELL_AURA_FAR_SIGHT, SPELL_AURA_NONE};
     for (AuraType const* type = &auratypes[0]; *type != SPELL_AURA_NONE; ++type)
     {
-        AuraList& alist = m_modAuras[*type];
-        if (alist.empty())
+        ModAuraBucket* bucket = GetModAuraBucket(*type);
+        if (!bucket || bucket->m_auras.empty())
             continue;
 
+        AuraList& alist = bucket->m_auras;
+
         for (AuraList::iterator it = alist.begin(); it != alist.end();)
         {
             Aura* aura = (*it);
@@ -8805,7 +8841,8 @@ void Unit::TauntFadeOut(Unit* taunter)
             ((Creature*)this)->AI()->EnterEvadeMode();
 
         if (InstanceData* mapInstance = GetInstanceData())
-            mapInstance->OnCreatureEvade((Creature*)this);
+            if (!GetMap()->DeferCombatHook((Creature*)this, true))
+                mapInstance->OnCreatureEvade((Creature*)this);
 
         if (m_isCreatureLinkingTrigger)
             GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_EVADE, (Creature*)this);
@@ -8966,7 +9003,8 @@ bool Unit::SelectHostileTarget()
     ((Creature*)this)->AI()->EnterEvadeMode();
 
     if (InstanceData* mapInstance = GetInstanceData())
-        mapInstance->OnCreatureEvade((Creature*)this);
+        if (!GetMap()->DeferCombatHook((Creature*)this, true))
+            mapInstance->OnCreatureEvade((Creature*)this);
 
     if (m_isCreatureLinkingTrigger)
         GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_EVADE, (Creature*)this);
@@ -9629,7 +9667,7 @@ void Unit::ApplyMaxPowerMod(Powers power, uint32 val, bool apply)
 
 void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
 {
-    AuraList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
+    AuraList& tAuraProcTriggerDamage = GetModAuraList(SPELL_AURA_PROC_TRIGGER_DAMAGE);
     if (apply)
         tAuraProcTriggerDamage.push_back(aura);
     else
@@ -9675,6 +9713,9 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    // a pending relocation notification stays with the old map, it is dropped there
+    m_AINotifyScheduled = false;
+
     Object::RemoveFromWorld();
 }
 
@@ -11098,44 +11139,13 @@ bool Unit::IsAllowedDamageInArea(Unit* pVictim) const
     return true;
 }
 
-class RelocationNotifyEvent : public BasicEvent
-{
-    public:
-        RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
-        {
-            m_owner._SetAINotifyScheduled(true);
-        }
-
-        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
-        {
-            float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.GetTypeId() == TYPEID_PLAYER)
-            {
-                MaNGOS::PlayerRelocationNotifier notify((Player&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if(m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            m_owner._SetAINotifyScheduled(false);
-            return true;
-        }
-
-        void Abort(uint64)
-        {
-            m_owner._SetAINotifyScheduled(false);
-        }
-
-    private:
-        Unit& m_owner;
-};
-
 void Unit::ScheduleAINotify(uint32 delay)
 {
-    if (!IsAINotifyScheduled())
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
+    if (!IsAINotifyScheduled() && IsInWorld())
+    {
+        m_AINotifyScheduled = true;
+        GetMap()->ScheduleRelocationNotify(this, delay);
+    }
 }
 
 void Unit::OnRelocated()
@@ -1458,6 +1458,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         int32 DealHeal(Unit* pVictim, uint32 addhealth, SpellEntry const* spellProto, bool critical = false, uint32 absorb = 0);
 
         void PetOwnerKilledUnit(Unit* pVictim);
+        void InformCreatureDeathHooks(Creature* victim, Player* responsiblePlayer);
 
         void ProcDamageAndSpell(Unit* pVictim, uint32 procAttacker, uint32 procVictim, uint32 procEx, uint32 amount, WeaponAttackType attType = BASE_ATTACK, SpellEntry const* procSpell = NULL);
         void ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellEntry const* procSpell, uint32 damage);
@@ -1902,9 +1903,21 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         SpellAuraHolderMap&       GetSpellAuraHolderMap()       { return m_spellAuraHolders; }
         SpellAuraHolderMap const& GetSpellAuraHolderMap() const { return m_spellAuraHolders; }
-        AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
+        AuraList const& GetAurasByType(AuraType type) const
+        {
+            ModAuraBucket const* bucket = GetModAuraBucket(type);
+            return bucket ? bucket->m_auras : s_emptyAuraList;
+        }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
+        // GetTotalAuraModifier/GetTotalAuraMultiplier are cached until the auras of the type are changed,
+        // call this when the amount of an aura is changed without reapplying it
+        void InvalidateAuraTotals(AuraType type)
+        {
+            if (ModAuraBucket* bucket = GetModAuraBucket(type))
+                bucket->m_totalsValid = false;
+        }
+
         int32 GetTotalAuraModifier(AuraType auratype) const;
         float GetTotalAuraMultiplier(AuraType auratype) const;
         int32 GetMaxPositiveAuraModifier(AuraType auratype) const;
@@ -2097,7 +2110,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from Map::ProcessRelocationNotifies
         void OnRelocated();
 
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
@@ -2134,7 +2147,28 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
         bool m_isSorted;
         uint32 m_transform;
 
-        AuraList m_modAuras[TOTAL_AURAS];
+        // auras by type, a unit only has auras of few types so the lists are allocated when the first one is added
+        struct ModAuraBucket
+        {
+            ModAuraBucket() : m_totalModifier(0), m_totalMultiplier(1.0f), m_totalsValid(false) {}
+
+            AuraList m_auras;
+            int32 m_totalModifier;                          ///< cached GetTotalAuraModifier
+            float m_totalMultiplier;                        ///< cached GetTotalAuraMultiplier
+            bool m_totalsValid;
+        };
+
+        ModAuraBucket* GetModAuraBucket(AuraType type) const
+        {
+            uint16 index = m_modAuraIndex[type];
+            return index ? m_modAuraBuckets[index - 1] : NULL;
+        }
+        AuraList& GetModAuraList(AuraType type);
+        ModAuraBucket const* GetModAuraTotals(AuraType type) const;
+
+        uint16 m_modAuraIndex[TOTAL_AURAS];                 ///< 0 if the unit never had auras of the type, else index + 1 in m_modAuraBuckets
+        std::vector<ModAuraBucket*> m_modAuraBuckets;       ///< kept when emptied, GetAurasByType references stay valid
+        static AuraList const s_emptyAuraList;
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
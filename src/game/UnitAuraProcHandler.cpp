@@ -1070,6 +1070,7 @@ SpellAuraProcResult Unit::HandleDummyAuraProc(Unit* pVictim, uint32 damage, Aura
                 if (procEx & PROC_EX_CRITICAL_HIT)
                 {
                     mod->m_amount *= 2;
+                    InvalidateAuraTotals(mod->m_auraname);
                     if (mod->m_amount < 100) // not enough
                         return SPELL_AURA_PROC_OK;
                     // Critical counted -> roll chance
@@ -1077,6 +1078,7 @@ SpellAuraProcResult Unit::HandleDummyAuraProc(Unit* pVictim, uint32 damage, Aura
                         CastSpell(this, 48108, true, castItem, triggeredByAura);
                 }
                 mod->m_amount = 25;
+                InvalidateAuraTotals(mod->m_auraname);
                 return SPELL_AURA_PROC_OK;
             }
             // Burnout
@@ -25,6 +25,7 @@
 #include "World.h"
 #include "ObjectGuid.h"
 #include <zlib.h>
+#include <boost/thread/tss.hpp>
 
 UpdateData::UpdateData() : m_blockCount(0)
 {
@@ -40,35 +41,92 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::AddUpdateBlock(const ByteBuffer& block)
+size_t UpdateData::AddUpdateBlock(const ByteBuffer& block)
 {
+    size_t pos = m_data.wpos();
     m_data.append(block);
     ++m_blockCount;
+    return pos;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+/**
+ * Deflate state kept by each thread compressing update packets.
+ *
+ * deflateInit allocates a few hundred KB of zlib state, so instead of creating it for every
+ * packet the stream is only reset between packets and recreated when the level changes.
+ */
+class UpdateCompressor
 {
-    z_stream c_stream;
+    public:
+        UpdateCompressor() : m_level(-1) {}
+        ~UpdateCompressor()
+        {
+            if (m_level >= 0)
+                deflateEnd(&m_stream);
+        }
+
+        // returns the stream ready for a new packet or NULL if zlib can't be initialised
+        z_stream* GetStream(int level)
+        {
+            if (m_level == level)
+            {
+                int z_res = deflateReset(&m_stream);
+                if (z_res == Z_OK)
+                    return &m_stream;
+
+                sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+            }
+
+            if (m_level >= 0)
+            {
+                deflateEnd(&m_stream);
+                m_level = -1;
+            }
+
+            m_stream.zalloc = (alloc_func)0;
+            m_stream.zfree = (free_func)0;
+            m_stream.opaque = (voidpf)0;
+
+            int z_res = deflateInit(&m_stream, level);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                return NULL;
+            }
+
+            m_level = level;
+            return &m_stream;
+        }
+
+    private:
+        UpdateCompressor(const UpdateCompressor&);
+        UpdateCompressor& operator=(const UpdateCompressor&);
+
+        z_stream m_stream;
+        int m_level;                                        ///< level of the initialised stream, -1 if none
+};
+
+static boost::thread_specific_ptr<UpdateCompressor> updateCompressor;
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    if (!updateCompressor.get())
+        updateCompressor.reset(new UpdateCompressor);
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = updateCompressor->GetStream(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -76,14 +134,14 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -91,15 +149,28 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    *dst_size = c_stream->total_out;
+}
+
+bool UpdateData::CompressPacket(uint8 const* data, size_t size, WorldPacket* packet)
+{
+    uint32 destsize = compressBound(size);
+    packet->resize(destsize + sizeof(uint32));
+
+    packet->put<uint32>(0, size);
+    Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)data, size);
+    if (destsize == 0)
+        return false;
+
+    packet->resize(destsize + sizeof(uint32));
+    packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    return true;
+}
 
-    *dst_size = c_stream.total_out;
+bool UpdateData::IsCompressedByNetworkThread(WorldPacket const& packet)
+{
+    return packet.GetOpcode() == SMSG_UPDATE_OBJECT && sWorld.getConfig(CONFIG_BOOL_COMPRESSION_NETWORK_THREAD) &&
+           packet.size() > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD);
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -123,18 +194,11 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                        // compress large packets
+    // compress large packets, unless the network thread of the receiver does it
+    if (pSize > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD) && !sWorld.getConfig(CONFIG_BOOL_COMPRESSION_NETWORK_THREAD))
     {
-        uint32 destsize = compressBound(pSize);
-        packet->resize(destsize + sizeof(uint32));
-
-        packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-        if (destsize == 0)
+        if (!CompressPacket(buf.contents(), pSize, packet))
             return false;
-
-        packet->resize(destsize + sizeof(uint32));
-        packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
     }
     else                                                    // send small packets without compression
     {
@@ -56,18 +56,25 @@ class UpdateData
 
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
-        void AddUpdateBlock(const ByteBuffer& block);
+        // returns the position of the block, fields of it can be changed with PutUpdateValue
+        size_t AddUpdateBlock(const ByteBuffer& block);
+        void PutUpdateValue(size_t pos, uint32 value) { m_data.put<uint32>(pos, value); }
         bool BuildPacket(WorldPacket* packet);
         bool HasData() { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        // builds SMSG_COMPRESSED_UPDATE_OBJECT from the content of a SMSG_UPDATE_OBJECT into the empty packet
+        static bool CompressPacket(uint8 const* data, size_t size, WorldPacket* packet);
+        // raw update packets left to the network thread of the receiver for compression
+        static bool IsCompressedByNetworkThread(WorldPacket const& packet);
+
     protected:
         uint32 m_blockCount;
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
-        void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
 #endif
@@ -48,6 +48,37 @@ class UpdateMask
             return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
         }
 
+        // first set bit at or after index, GetCount() if there is none
+        uint32 FindNextBit(uint32 index) const
+        {
+            while (index < mCount)
+            {
+                // skip whole blocks without set bits
+                if (!(index & 31) && !mUpdateMask[index >> 5])
+                {
+                    index += 32;
+                    continue;
+                }
+
+                uint8 bits = ((uint8*)mUpdateMask)[ index >> 3 ] >> (index & 0x7);
+                if (!bits)
+                {
+                    index = (index | 0x7) + 1;
+                    continue;
+                }
+
+                while (!(bits & 1))
+                {
+                    bits >>= 1;
+                    ++index;
+                }
+
+                return index;
+            }
+
+            return mCount;
+        }
+
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
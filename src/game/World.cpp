@@ -67,6 +67,9 @@
 #include "CharacterDatabaseCleaner.h"
 #include "CreatureLinkingMgr.h"
 #include "Calendar.h"
+#include "LoadingStage.h"
+
+#include <boost/bind.hpp>
 
 INSTANTIATE_SINGLETON_1(World);
 
@@ -534,6 +537,8 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 100);
+    setConfig(CONFIG_BOOL_COMPRESSION_NETWORK_THREAD, "Compression.NetworkThread", false);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -545,10 +550,27 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetGridCleanUpDelay(getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN));
 
+    setConfig(CONFIG_UINT32_GRID_PREFETCH_TIME, "GridPrefetchTime", 10000);
+
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0);
+
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_CELL_THREADS, "MapUpdate.CellThreads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_CELL_THREADS, "MapUpdate.CellThreads", 0);
+
+    if (configNoReload(reload, CONFIG_UINT32_MMAP_PATH_THREADS, "mmap.pathThreads", 0))
+        setConfig(CONFIG_UINT32_MMAP_PATH_THREADS, "mmap.pathThreads", 0);
+
+    setConfig(CONFIG_UINT32_MMAP_PATH_REQUESTS_PER_TICK, "mmap.pathRequestsPerTick", 100);
+    setConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE, "mmap.pathCacheSize", 256);
+
+    if (configNoReload(reload, CONFIG_UINT32_LOADING_THREADS, "Loading.Threads", 1))
+        setConfig(CONFIG_UINT32_LOADING_THREADS, "Loading.Threads", 1);
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -1020,62 +1042,37 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading GameObject models...");
     LoadGameObjectModelList();
 
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+    uint32 loadingThreads = getConfig(CONFIG_UINT32_LOADING_THREADS);
 
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Items...");                     // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
+    {
+        LoadingStage stage("spell data");
+        uint32 chains = stage.Add("Spell Chain Data", boost::bind(&SpellMgr::LoadSpellChains, &sSpellMgr));
+        stage.Add("Spell Elixir types", boost::bind(&SpellMgr::LoadSpellElixirs, &sSpellMgr));
+        stage.Add("Spell Learn Skills", boost::bind(&SpellMgr::LoadSpellLearnSkills, &sSpellMgr), chains);
+        stage.Add("Spell Learn Spells", boost::bind(&SpellMgr::LoadSpellLearnSpells, &sSpellMgr));
+        stage.Add("Spell Proc Event conditions", boost::bind(&SpellMgr::LoadSpellProcEvents, &sSpellMgr), chains);
+        stage.Add("Spell Bonus Data", boost::bind(&SpellMgr::LoadSpellBonuses, &sSpellMgr), chains);
+        stage.Add("Spell Proc Item Enchant", boost::bind(&SpellMgr::LoadSpellProcItemEnchant, &sSpellMgr), chains);
+        stage.Add("Aggro Spells Definitions", boost::bind(&SpellMgr::LoadSpellThreats, &sSpellMgr), chains);
+        stage.Add("NPC Texts", boost::bind(&ObjectMgr::LoadGossipText, &sObjectMgr));
+        stage.Add("Item Random Enchantments Table", &LoadRandomEnchantmentsTable);
+        stage.Run(loadingThreads);
+    }
 
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
+    {
+        // items and creatures only read each other's data later, each chain fills its own storages
+        LoadingStage stage("item and creature templates");
+        uint32 items = stage.Add("Items", boost::bind(&ObjectMgr::LoadItemPrototypes, &sObjectMgr));    // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+        stage.Add("Item converts", boost::bind(&ObjectMgr::LoadItemConverts, &sObjectMgr), items);
+        stage.Add("Item expire converts", boost::bind(&ObjectMgr::LoadItemExpireConverts, &sObjectMgr), items);
+        uint32 models = stage.Add("Creature Model Based Info Data", boost::bind(&ObjectMgr::LoadCreatureModelInfo, &sObjectMgr));
+        uint32 equipment = stage.Add("Equipment templates", boost::bind(&ObjectMgr::LoadEquipmentTemplates, &sObjectMgr));
+        uint32 stats = stage.Add("Creature Stats", boost::bind(&ObjectMgr::LoadCreatureClassLvlStats, &sObjectMgr));
+        uint32 creatures = stage.Add("Creature templates", boost::bind(&ObjectMgr::LoadCreatureTemplates, &sObjectMgr), models, equipment, stats);
+        stage.Add("Creature template spells", boost::bind(&ObjectMgr::LoadCreatureTemplateSpells, &sObjectMgr), creatures);
+        stage.Add("Creature Model for race", boost::bind(&ObjectMgr::LoadCreatureModelRace, &sObjectMgr), creatures);
+        stage.Run(loadingThreads);
+    }
 
     sLog.outString("Loading SpellsScriptTarget...");
     sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
@@ -1083,29 +1080,25 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Vehicle Accessory...");         // must be after creature templates
     sObjectMgr.LoadVehicleAccessory();
 
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString("Loading pet levelup spells...");
-    sSpellMgr.LoadPetLevelupSpellMap();
+    {
+        LoadingStage stage("reputation and points of interest");
+        stage.Add("ItemRequiredTarget", boost::bind(&ObjectMgr::LoadItemRequiredTarget, &sObjectMgr));
+        stage.Add("Reputation Reward Rates", boost::bind(&ObjectMgr::LoadReputationRewardRate, &sObjectMgr));
+        stage.Add("Creature Reputation OnKill Data", boost::bind(&ObjectMgr::LoadReputationOnKill, &sObjectMgr));
+        stage.Add("Reputation Spillover Data", boost::bind(&ObjectMgr::LoadReputationSpilloverTemplate, &sObjectMgr));
+        stage.Add("Points Of Interest Data", boost::bind(&ObjectMgr::LoadPointsOfInterest, &sObjectMgr));
+        stage.Run(loadingThreads);
+    }
 
-    sLog.outString("Loading pet default spell additional to levelup spells...");
-    sSpellMgr.LoadPetDefaultSpells();
+    {
+        LoadingStage stage("creature and gameobject spawns");
+        stage.Add("Creature Data", boost::bind(&ObjectMgr::LoadCreatures, &sObjectMgr));
+        stage.Add("pet levelup spells", boost::bind(&SpellMgr::LoadPetLevelupSpellMap, &sSpellMgr));
+        stage.Add("pet default spell additional to levelup spells", boost::bind(&SpellMgr::LoadPetDefaultSpells, &sSpellMgr));
+        uint32 gameobjects = stage.Add("Gameobject Data", boost::bind(&ObjectMgr::LoadGameObjects, &sObjectMgr));
+        stage.Add("Gameobject Addon Data", boost::bind(&ObjectMgr::LoadGameObjectAddon, &sObjectMgr), gameobjects);
+        stage.Run(loadingThreads);
+    }
 
     sLog.outString("Loading Creature Addon Data...");
     sLog.outString();
@@ -1113,12 +1106,6 @@ void World::SetInitialWorldSettings()
     sLog.outString(">>> Creature Addon Data loaded");
     sLog.outString();
 
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
-
-    sLog.outString("Loading Gameobject Addon Data...");
-    sObjectMgr.LoadGameObjectAddon();
-
     sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
     sCreatureLinkingMgr.LoadFromDB();
 
@@ -1189,46 +1176,34 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading spell pet auras...");
     sSpellMgr.LoadSpellPetAuras();
 
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sLog.outString();
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
+    {
+        LoadingStage stage("player and pet data");
+        stage.Add("Player Create Info & Level Stats", boost::bind(&ObjectMgr::LoadPlayerInfo, &sObjectMgr));
+        stage.Add("Exploration BaseXP Data", boost::bind(&ObjectMgr::LoadExplorationBaseXP, &sObjectMgr));
+        stage.Add("Pet Name Parts", boost::bind(&ObjectMgr::LoadPetNames, &sObjectMgr));
+        stage.Add("pet level stats", boost::bind(&ObjectMgr::LoadPetLevelInfo, &sObjectMgr));
+        stage.Run(loadingThreads);
+    }
 
     CharacterDatabaseCleaner::CleanDatabase();
 
     sLog.outString("Loading the max pet number...");
     sObjectMgr.LoadPetNumber();
 
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
-
     sLog.outString("Loading Player Corpses...");
     sObjectMgr.LoadCorpses();
 
     sLog.outString("Loading Player level dependent mail rewards...");
     sObjectMgr.LoadMailLevelRewards();
 
-    sLog.outString("Loading Loot Tables...");
-    sLog.outString();
-    LoadLootTables();
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
+    {
+        LoadingStage stage("loot and skill tables");
+        stage.Add("Loot Tables", &LoadLootTables);
+        stage.Add("Skill Discovery Table", &LoadSkillDiscoveryTable);
+        stage.Add("Skill Extra Item Table", &LoadSkillExtraItemTable);
+        stage.Add("Skill Fishing base level requirements", boost::bind(&ObjectMgr::LoadFishingBaseSkillLevel, &sObjectMgr));
+        stage.Run(loadingThreads);
+    }
 
     sLog.outString();
     sLog.outString("Loading Achievements...");
@@ -1692,13 +1667,14 @@ void World::SendWorldText(int32 string_id, ...)
 /// Sends a packet to all players with optional team and instance restrictions
 void World::SendGlobalMessage(WorldPacket* packet)
 {
+    BroadcastPacket broadcast(packet);
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
         if (itr->second &&
                 itr->second->GetPlayer() &&
                 itr->second->GetPlayer()->IsInWorld())
         {
-            itr->second->SendPacket(packet);
+            broadcast.SendTo(itr->second);
         }
     }
 }
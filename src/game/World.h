@@ -88,9 +88,17 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_THRESHOLD,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
+    CONFIG_UINT32_MAP_UPDATE_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_CELL_THREADS,
+    CONFIG_UINT32_MMAP_PATH_THREADS,
+    CONFIG_UINT32_MMAP_PATH_REQUESTS_PER_TICK,
+    CONFIG_UINT32_MMAP_PATH_CACHE_SIZE,
+    CONFIG_UINT32_GRID_PREFETCH_TIME,
+    CONFIG_UINT32_LOADING_THREADS,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_GAME_TYPE,
@@ -348,6 +356,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_MMAP_ENABLED,
     CONFIG_BOOL_PLAYER_COMMANDS,
+    CONFIG_BOOL_COMPRESSION_NETWORK_THREAD,
     CONFIG_BOOL_VALUE_COUNT
 };
 
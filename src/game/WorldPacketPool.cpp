@@ -0,0 +1,114 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "WorldPacketPool.h"
+
+#include <boost/thread/lock_guard.hpp>
+
+#define CLASS_LOCK MaNGOS::ClassLevelLockable<WorldPacketPool, boost::mutex>
+INSTANTIATE_SINGLETON_2(WorldPacketPool, CLASS_LOCK);
+INSTANTIATE_CLASS_MUTEX(WorldPacketPool, boost::mutex);
+
+// storage sizes handed out by the pool, the last one is the max client packet size
+const size_t WorldPacketPool::s_sizeClasses[MAX_SIZE_CLASSES] = { 64, 256, 1024, 4096, 10240 };
+
+WorldPacketPool::WorldPacketPool()
+{
+}
+
+WorldPacketPool::~WorldPacketPool()
+{
+    for (int i = 0; i < MAX_SIZE_CLASSES; ++i)
+    {
+        std::vector<WorldPacket*>& packets = m_freeLists[i].m_packets;
+        for (std::vector<WorldPacket*>::iterator itr = packets.begin(); itr != packets.end(); ++itr)
+            delete *itr;
+    }
+}
+
+WorldPacket* WorldPacketPool::Acquire(Opcodes opcode, size_t size)
+{
+    WorldPacket* packet = NULL;
+
+    int sizeClass = 0;
+    while (sizeClass < MAX_SIZE_CLASSES && s_sizeClasses[sizeClass] < size)
+        ++sizeClass;
+
+    if (sizeClass < MAX_SIZE_CLASSES)
+    {
+        FreeList& freeList = m_freeLists[sizeClass];
+
+        {
+            boost::lock_guard<boost::mutex> guard(freeList.m_lock);
+            if (!freeList.m_packets.empty())
+            {
+                packet = freeList.m_packets.back();
+                freeList.m_packets.pop_back();
+            }
+        }
+
+        if (packet)
+            packet->Initialize(opcode, s_sizeClasses[sizeClass]);
+        else
+            packet = new WorldPacket(opcode, s_sizeClasses[sizeClass]);
+    }
+    else
+        packet = new WorldPacket(opcode, size);
+
+    packet->resize(size);
+    return packet;
+}
+
+void WorldPacketPool::Release(WorldPacket* packet)
+{
+    if (!packet)
+        return;
+
+    size_t capacity = packet->capacity();
+
+    // don't hold on to storage grown far over the biggest client packet
+    if (capacity > 2 * s_sizeClasses[MAX_SIZE_CLASSES - 1])
+    {
+        delete packet;
+        return;
+    }
+
+    int sizeClass = MAX_SIZE_CLASSES - 1;
+    while (sizeClass >= 0 && s_sizeClasses[sizeClass] > capacity)
+        --sizeClass;
+
+    if (sizeClass >= 0)
+    {
+        FreeList& freeList = m_freeLists[sizeClass];
+
+        boost::lock_guard<boost::mutex> guard(freeList.m_lock);
+        if (freeList.m_packets.size() < MAX_POOLED_PACKETS)
+        {
+            freeList.m_packets.push_back(packet);
+            return;
+        }
+    }
+
+    delete packet;
+}
+
+WorldPacketHolder::~WorldPacketHolder()
+{
+    if (m_packet)
+        sWorldPacketPool.Release(m_packet);
+}
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLDPACKETPOOL_H
+#define MANGOS_WORLDPACKETPOOL_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "WorldPacket.h"
+
+#include <boost/thread/mutex.hpp>
+
+#include <vector>
+
+/**
+ * Recycles client packets between WorldSocket and WorldSession.
+ *
+ * Incoming packets are created on the network threads and destroyed on the map threads
+ * after their handler ran. Instead of freeing the storage every time, released packets are
+ * kept in free lists sorted by storage capacity and reused for the next packet of that size.
+ */
+class WorldPacketPool : public MaNGOS::Singleton<WorldPacketPool, MaNGOS::ClassLevelLockable<WorldPacketPool, boost::mutex> >
+{
+        friend class MaNGOS::OperatorNew<WorldPacketPool>;
+
+    public:
+        // get a packet with size() == size, the storage can be bigger
+        WorldPacket* Acquire(Opcodes opcode, size_t size);
+        // give the packet back to the pool, the pointer must not be used after this call
+        void Release(WorldPacket* packet);
+
+    private:
+        WorldPacketPool();
+        ~WorldPacketPool();
+
+        WorldPacketPool(const WorldPacketPool&);
+        WorldPacketPool& operator=(const WorldPacketPool&);
+
+        enum
+        {
+            MAX_SIZE_CLASSES    = 5,
+            MAX_POOLED_PACKETS  = 256                       // per size class
+        };
+
+        static const size_t s_sizeClasses[MAX_SIZE_CLASSES];
+
+        struct FreeList
+        {
+            boost::mutex m_lock;
+            std::vector<WorldPacket*> m_packets;
+        };
+
+        FreeList m_freeLists[MAX_SIZE_CLASSES];
+};
+
+/// Releases the held packet to the pool at scope exit, unless ownership was taken with release()
+class WorldPacketHolder
+{
+    public:
+        explicit WorldPacketHolder(WorldPacket* packet) : m_packet(packet) {}
+        ~WorldPacketHolder();
+
+        WorldPacket* release()
+        {
+            WorldPacket* packet = m_packet;
+            m_packet = NULL;
+            return packet;
+        }
+
+    private:
+        WorldPacketHolder(const WorldPacketHolder&);
+        WorldPacketHolder& operator=(const WorldPacketHolder&);
+
+        WorldPacket* m_packet;
+};
+
+#define sWorldPacketPool WorldPacketPool::Instance()
+
+#endif
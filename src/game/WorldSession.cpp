@@ -26,6 +26,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "WorldPacketPool.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "ObjectMgr.h"
@@ -109,7 +110,7 @@ WorldSession::~WorldSession()
     ///- empty incoming packet queue
     WorldPacket* packet = NULL;
     while (_recvQueue.next(packet))
-        delete packet;
+        sWorldPacketPool.Release(packet);
 }
 
 void WorldSession::SizeError(WorldPacket const& packet, uint32 size) const
@@ -170,6 +171,29 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket();
 }
 
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!m_Socket)
+        return;
+
+    if (!m_Socket->SendPacket(packet))
+        m_Socket->CloseSocket();
+}
+
+void BroadcastPacket::SendTo(WorldSession* session)
+{
+    if (!m_recipients++ || m_packet->size() < MIN_SHARED_PACKET_SIZE)
+    {
+        session->SendPacket(m_packet);
+        return;
+    }
+
+    if (!m_shared)
+        m_shared.reset(new WorldPacket(*m_packet));
+
+    session->SendPacket(m_shared);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -197,6 +221,9 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(PacketFilter& updater)
 {
+    // keep the character DB requests of this account in order if CharacterDatabase uses several async connections
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GetAccountId());
+
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = NULL;
@@ -293,7 +320,7 @@ bool WorldSession::Update(PacketFilter& updater)
             }
         }
 
-        delete packet;
+        sWorldPacketPool.Release(packet);
     }
 
     ///- Cleanup socket pointer if need
@@ -321,6 +348,8 @@ bool WorldSession::Update(PacketFilter& updater)
 /// %Log the player out
 void WorldSession::LogoutPlayer(bool Save)
 {
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, GetAccountId());
+
     // finish pending transfers before starting the logout
     while (_player && _player->IsBeingTeleportedFar())
         HandleMoveWorldportAckOpcode();
@@ -617,14 +646,6 @@ void WorldSession::SendAuthWaitQue(uint32 position)
     }
 }
 
-void WorldSession::LoadGlobalAccountData()
-{
-    LoadAccountData(
-        CharacterDatabase.PQuery("SELECT type, time, data FROM account_data WHERE account='%u'", GetAccountId()),
-        GLOBAL_CACHE_MASK
-    );
-}
-
 void WorldSession::LoadAccountData(QueryResult* result, uint32 mask)
 {
     for (uint32 i = 0; i < NUM_ACCOUNT_DATA_TYPES; ++i)
@@ -716,13 +737,11 @@ void WorldSession::SendAccountDataTimes(uint32 mask)
     SendPacket(&data);
 }
 
-void WorldSession::LoadTutorialsData()
+void WorldSession::LoadTutorialsData(QueryResult* result)
 {
     for (int aX = 0 ; aX < 8 ; ++aX)
         m_Tutorials[ aX ] = 0;
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT tut0,tut1,tut2,tut3,tut4,tut5,tut6,tut7 FROM character_tutorial WHERE account = '%u'", GetAccountId());
-
     if (!result)
     {
         m_tutorialState = TUTORIALDATA_NEW;
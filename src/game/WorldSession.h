@@ -226,6 +226,31 @@ class WorldSessionFilter : public PacketFilter
         virtual bool Process(WorldPacket* packet) override;
 };
 
+/**
+ * Sends one packet to many sessions, e.g. to all players seeing an object or to a group.
+ *
+ * The first recipient gets the packet copied into its socket like with WorldSession::SendPacket.
+ * For the following ones the payload is copied once into a shared packet that their sockets
+ * reference until it is sent, only the header is written and encrypted per socket.
+ */
+class MANGOS_DLL_SPEC BroadcastPacket
+{
+    public:
+        explicit BroadcastPacket(WorldPacket const* packet) : m_packet(packet), m_recipients(0) {}
+
+        void SendTo(WorldSession* session);
+
+    private:
+        enum
+        {
+            MIN_SHARED_PACKET_SIZE = 256                    // smaller packets are cheaper to copy than to share
+        };
+
+        WorldPacket const* m_packet;
+        boost::shared_ptr<WorldPacket const> m_shared;      ///< created for the second recipient
+        uint32 m_recipients;
+};
+
 /// Player session in the World
 class MANGOS_DLL_SPEC WorldSession
 {
@@ -245,6 +270,7 @@ class MANGOS_DLL_SPEC WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        void SendPacket(boost::shared_ptr<WorldPacket const> const& packet); // use BroadcastPacket to send to many sessions
         void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName);
@@ -334,9 +360,8 @@ class MANGOS_DLL_SPEC WorldSession
         AccountData* GetAccountData(AccountDataType type) { return &m_accountData[type]; }
         void SetAccountData(AccountDataType type, time_t time_, std::string data);
         void SendAccountDataTimes(uint32 mask);
-        void LoadGlobalAccountData();
         void LoadAccountData(QueryResult* result, uint32 mask);
-        void LoadTutorialsData();
+        void LoadTutorialsData(QueryResult* result);
         void SendTutorialsData();
         void SaveTutorialsData();
         uint32 GetTutorialInt(uint32 intId)
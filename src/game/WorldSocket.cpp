@@ -19,7 +19,6 @@
 #include "WorldSocket.h"
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
-#include <boost/date_time/posix_time/posix_time_duration.hpp>
 #include "Common.h"
 #include "Util.h"
 #include "World.h"
@@ -28,14 +27,19 @@
 #include "ByteBuffer.h"
 #include "Opcodes.h"
 #include "DatabaseEnv.h"
+#include "DatabaseImpl.h"
 #include "Sha1.h"
 #include "WorldSession.h"
 #include "WorldSocketMgr.h"
+#include "NetworkThread.h"
+#include "WorldPacketPool.h"
+#include "UpdateData.h"
 #include "Log.h"
 #include "DBCStores.h"
 
 WorldSocket::WorldSocket(NetworkManager& socketMrg, NetworkThread& owner) : Socket(socketMrg, owner), packet_(nullptr),
-    received_header_(false), m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), session_(0), seed_(static_cast<uint32>(rand32()))
+    received_header_(false), auth_pending_(false), m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), session_(0), seed_(static_cast<uint32>(rand32())),
+    deferred_flush_pending_(false)
 {
 
 }
@@ -43,7 +47,7 @@ WorldSocket::WorldSocket(NetworkManager& socketMrg, NetworkThread& owner) : Sock
 WorldSocket::~WorldSocket(void)
 {
     if (packet_ != nullptr)
-        delete packet_;
+        sWorldPacketPool.Release(packet_);
 }
 
 void WorldSocket::CloseSocket(void)
@@ -57,6 +61,16 @@ void WorldSocket::CloseSocket(void)
 }
 
 bool WorldSocket::SendPacket(const WorldPacket& pct)
+{
+    return SendPacket(pct, NULL);
+}
+
+bool WorldSocket::SendPacket(const SharedWorldPacket& pct)
+{
+    return SendPacket(*pct, &pct);
+}
+
+bool WorldSocket::SendPacket(const WorldPacket& pct, const SharedWorldPacket* shared)
 {
     if (IsClosed())
         return false;
@@ -64,29 +78,159 @@ bool WorldSocket::SendPacket(const WorldPacket& pct)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(native_handle(), pct.GetOpcode(), pct.GetOpcodeName(), &pct, false);
 
+    if (pct.MarkSent())
+        RecordSentPacket(pct.GetOpcode(), pct.size(), pct.IsOutgrown());
+
+    {
+        GuardType Guard(out_buffer_lock_);
+
+        // closed meanwhile, nothing to report
+        if (!IsOpenForSending())
+            return false;
+
+        if (deferred_flush_pending_ || UpdateData::IsCompressedByNetworkThread(pct))
+        {
+            DeferPacket(shared ? *shared : SharedWorldPacket(new WorldPacket(pct)));
+            return true;
+        }
+
+        if (QueuePacket(pct, shared))
+        {
+            StartAsyncSend();
+            return true;
+        }
+    }
+
+    OnOutgoingLimitReached(pct);
+    return false;
+}
+
+bool WorldSocket::QueuePacket(const WorldPacket& pct, const SharedWorldPacket* shared)
+{
     ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
+
+    if (!CanQueueOutgoing(pct.size() + header.getHeaderLength()))
+        return false;
+
+    // Encrypt under the lock, headers must reach the queue in encryption order.
     crypt_.EncryptSend((uint8*) header.header, header.getHeaderLength());
 
-    GuardType Guard(out_buffer_lock_);
+    // Put the packet on the queue.
+    QueueOutgoing(header.header, header.getHeaderLength());
 
-    if (out_buffer_->space() >= pct.size() + header.getHeaderLength())
-    {
-        // Put the packet on the buffer.
-        if (!out_buffer_->Write(header.header, header.getHeaderLength()))
-            MANGOS_ASSERT(false);
+    if (shared)
+        QueueOutgoing(SharedPayload(*shared));
+    else if (!pct.empty())
+        QueueOutgoing(pct.contents(), pct.size());
 
-        if (!pct.empty() && !out_buffer_->Write(pct.contents(), pct.size()))
-            MANGOS_ASSERT(false);
-    }
-    else
+    return true;
+}
+
+void WorldSocket::DeferPacket(const SharedWorldPacket& pct)
+{
+    deferred_.push_back(pct);
+
+    if (deferred_flush_pending_)
+        return;
+
+    deferred_flush_pending_ = true;
+
+    WorldSocketPtr this_socket = boost::static_pointer_cast<WorldSocket>(shared_from_this());
+    owner().service().post(boost::bind(&WorldSocket::FlushDeferredPackets, this_socket));
+}
+
+void WorldSocket::FlushDeferredPackets()
+{
+    DeferredQueue packets;
+
+    for (;;)
     {
-        // Enqueue the packet.
-        throw std::exception("network write buffer is too small to accommodate packet");
+        {
+            GuardType Guard(out_buffer_lock_);
+
+            if (deferred_.empty() || IsClosed())
+            {
+                deferred_.clear();
+                deferred_flush_pending_ = false;
+                return;
+            }
+
+            packets.swap(deferred_);
+        }
+
+        // Compress without the lock, map threads keep deferring packets meanwhile.
+        for (DeferredQueue::iterator itr = packets.begin(); itr != packets.end(); ++itr)
+        {
+            if (!UpdateData::IsCompressedByNetworkThread(**itr))
+                continue;
+
+            // broadcast packets are compressed by the first of their receivers
+            if (SharedWorldPacket sendForm = (*itr)->GetSendForm())
+            {
+                *itr = sendForm;
+                continue;
+            }
+
+            // a raw update packet is still valid if compression fails
+            WorldPacket* compressed = new WorldPacket(SMSG_COMPRESSED_UPDATE_OBJECT, 0);
+            if (UpdateData::CompressPacket((*itr)->contents(), (*itr)->size(), compressed))
+            {
+                SharedWorldPacket sendForm(compressed);
+                (*itr)->SetSendForm(sendForm);
+                *itr = sendForm;
+            }
+            else
+                delete compressed;
+        }
+
+        DeferredQueue::const_iterator failed = packets.end();
+
+        {
+            GuardType Guard(out_buffer_lock_);
+
+            // closed while compressing
+            if (!IsOpenForSending())
+            {
+                deferred_.clear();
+                deferred_flush_pending_ = false;
+                return;
+            }
+
+            for (DeferredQueue::const_iterator itr = packets.begin(); itr != packets.end(); ++itr)
+            {
+                if (!QueuePacket(**itr, &*itr))
+                {
+                    failed = itr;
+                    break;
+                }
+            }
+
+            if (failed == packets.end())
+                StartAsyncSend();
+        }
+
+        if (failed != packets.end())
+        {
+            OnOutgoingLimitReached(**failed);
+
+            GuardType Guard(out_buffer_lock_);
+            deferred_.clear();
+            deferred_flush_pending_ = false;
+            return;
+        }
+
+        packets.clear();
     }
+}
 
-    StartAsyncSend();
+void WorldSocket::OnOutgoingLimitReached(const WorldPacket& pct)
+{
+    // Client doesn't read its data fast enough, don't let the queue grow without bounds.
+    sLog.outError("WorldSocket::SendPacket: outgoing queue limit reached for %s (queued " SIZEFMTD " bytes, opcode %s), closing connection",
+                  GetRemoteAddress().c_str(), GetOutgoingQueueSize(), pct.GetOpcodeName());
 
-    return true;
+    owner().OnOutgoingLimitReached();
+    CloseSocket();
 }
 
 bool WorldSocket::Open()
@@ -153,12 +297,7 @@ bool WorldSocket::ValidatePacketHeader()
     if (header_.IsValid())
     {
         header_.size -= 4;
-        packet_ = new WorldPacket((Opcodes) header_.cmd, header_.size);
-
-        if (header_.size > 0)
-            packet_->resize(header_.size);
-        else
-            MANGOS_ASSERT(packet_->size() == 0);
+        packet_ = sWorldPacketPool.Acquire((Opcodes) header_.cmd, header_.size);
 
         return true;
     }
@@ -172,22 +311,39 @@ bool WorldSocket::ReadPacketContent()
 {
     MANGOS_ASSERT(packet_ != nullptr);
 
-    if (packet_->size() > 0)
+    size_t size = packet_->size();
+
+    if (size > 0 && !read_buffer_->Read((uint8*) packet_->contents(), size))
     {
-        if (!read_buffer_->Read((uint8*) packet_->contents(), packet_->size()))
-            return false;
+        // Packet can't fit the read buffer, take what is there and read the rest into the packet itself
+        if (size > read_buffer_->capacity())
+        {
+            size_t available = read_buffer_->length();
+            read_buffer_->Read((uint8*) packet_->contents(), available);
+            ReadDirect((uint8*) packet_->contents() + available, size - available);
+        }
+
+        return false;
     }
 
     received_header_ = false;
     return true;
 }
 
+bool WorldSocket::ProcessDirectReadData()
+{
+    received_header_ = false;
+
+    return ProcessPacket(packet_);
+}
+
 bool WorldSocket::ProcessPacket(WorldPacket* new_pct)
 {
     MANGOS_ASSERT(new_pct);
 
     // manage memory ;)
-    std::auto_ptr<WorldPacket> aptr(new_pct);
+    WorldPacketHolder aptr(new_pct);
+    packet_ = nullptr;
 
     const uint16 opcode = new_pct->GetOpcode();
 
@@ -210,7 +366,7 @@ bool WorldSocket::ProcessPacket(WorldPacket* new_pct)
             case CMSG_PING:
                 return HandlePing(*new_pct);
             case CMSG_AUTH_SESSION:
-                if (session_)
+                if (session_ || auth_pending_)
                 {
                     sLog.outError("WorldSocket::ProcessIncoming: Player send CMSG_AUTH_SESSION again");
                     return false;
@@ -259,22 +415,137 @@ bool WorldSocket::ProcessPacket(WorldPacket* new_pct)
         }
     }
 
-    packet_ = nullptr;
-
     return true;
 }
 
+enum AuthSessionQuery
+{
+    AUTH_SESSION_QUERY_ACCOUNT      = 0,
+    AUTH_SESSION_QUERY_BANNED       = 1,
+
+    MAX_AUTH_SESSION_QUERY
+};
+
+// Keeps what was read from CMSG_AUTH_SESSION while the realmd database is asked about the account
+class AuthSessionQueryHolder : public SqlQueryHolder
+{
+    public:
+        AuthSessionQueryHolder(WorldSocketPtr socket, const std::string& account, uint32 clientSeed, const uint8* digest)
+            : m_socket(socket), m_account(account), m_clientSeed(clientSeed), m_addonData(CMSG_AUTH_SESSION)
+        {
+            memcpy(m_digest, digest, sizeof(m_digest));
+        }
+
+        bool Initialize(const std::string& safeAccount, const std::string& address);
+
+        WorldSocketPtr m_socket;
+        std::string m_account;
+        uint32 m_clientSeed;
+        uint8 m_digest[20];
+        WorldPacket m_addonData;                            // rest of CMSG_AUTH_SESSION, read by WorldSession::ReadAddonsInfo
+};
+
+bool AuthSessionQueryHolder::Initialize(const std::string& safeAccount, const std::string& address)
+{
+    SetSize(MAX_AUTH_SESSION_QUERY);
+
+    bool res = true;
+
+    res &= SetPQuery(AUTH_SESSION_QUERY_ACCOUNT, "SELECT "
+                     "id, "                      //0
+                     "gmlevel, "                 //1
+                     "sessionkey, "              //2
+                     "last_ip, "                 //3
+                     "locked, "                  //4
+                     "v, "                       //5
+                     "s, "                       //6
+                     "expansion, "               //7
+                     "mutetime, "                //8
+                     "locale "                   //9
+                     "FROM account "
+                     "WHERE username = '%s'",
+                     safeAccount.c_str());
+
+    // Re-check account ban (same check as in realmd)
+    res &= SetPQuery(AUTH_SESSION_QUERY_BANNED,
+                     "SELECT 1 FROM account_banned WHERE id = (SELECT id FROM account WHERE username = '%s') AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)"
+                     "UNION "
+                     "SELECT 1 FROM ip_banned WHERE (unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'",
+                     safeAccount.c_str(), address.c_str());
+
+    return res;
+}
+
+// LoginDatabase results are delivered in the world thread,
+// the handshake is finished in the network thread that owns the socket
+class AuthSessionHandler
+{
+    public:
+        void HandleAuthSessionCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder) return;
+            // owned by the posted handler, so it is freed as well if the io_service stops before running it
+            boost::shared_ptr<AuthSessionQueryHolder> authHolder((AuthSessionQueryHolder*)holder);
+            WorldSocketPtr socket = authHolder->m_socket;
+            socket->owner().service().post(boost::bind(&WorldSocket::HandleAuthSessionResult, socket, authHolder));
+        }
+} authSessionHandler;
+
+enum AccountDataQuery
+{
+    ACCOUNT_DATA_QUERY_GLOBAL       = 0,
+    ACCOUNT_DATA_QUERY_TUTORIALS    = 1,
+
+    MAX_ACCOUNT_DATA_QUERY
+};
+
+// Account wide data of an authenticated session, read from the character database before it joins the world
+class AccountDataQueryHolder : public SqlQueryHolder
+{
+    public:
+        explicit AccountDataQueryHolder(WorldSession* session) : m_session(session) {}
+
+        bool Initialize();
+
+        WorldSession* m_session;
+};
+
+bool AccountDataQueryHolder::Initialize()
+{
+    SetSize(MAX_ACCOUNT_DATA_QUERY);
+
+    bool res = true;
+    res &= SetPQuery(ACCOUNT_DATA_QUERY_GLOBAL, "SELECT type, time, data FROM account_data WHERE account='%u'", m_session->GetAccountId());
+    res &= SetPQuery(ACCOUNT_DATA_QUERY_TUTORIALS, "SELECT tut0,tut1,tut2,tut3,tut4,tut5,tut6,tut7 FROM character_tutorial WHERE account = '%u'", m_session->GetAccountId());
+    return res;
+}
+
+// CharacterDatabase results are delivered in the world thread, the session is added to the world there
+class AccountDataHandler
+{
+    public:
+        void HandleAccountDataCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder) return;
+            AccountDataQueryHolder* dataHolder = (AccountDataQueryHolder*)holder;
+            WorldSession* session = dataHolder->m_session;
+
+            session->LoadAccountData(dataHolder->GetResult(ACCOUNT_DATA_QUERY_GLOBAL), GLOBAL_CACHE_MASK);
+            session->LoadTutorialsData(dataHolder->GetResult(ACCOUNT_DATA_QUERY_TUTORIALS));
+            delete dataHolder;
+
+            // a session whose socket was closed meanwhile is removed by the world as usual
+            sWorld.AddSession(session);
+        }
+} accountDataHandler;
+
 bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 {
     // NOTE: ATM the socket is singlethread, have this in mind ...
     uint8 digest[20];
-    uint32 clientSeed, id, security;
+    uint32 clientSeed;
     uint32 ClientBuild;
-    uint8 expansion = 0;
-    LocaleConstant locale;
     std::string account;
-    Sha1Hash sha1;
-    BigNumber v, s, g, N, K;
     WorldPacket packet;
 
     // Read the content of the packet
@@ -308,21 +579,55 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     LoginDatabase.escape_string(safe_account);
     // No SQL injection, username escaped.
 
-    QueryResult* result =
-        LoginDatabase.PQuery("SELECT "
-                             "id, "                      //0
-                             "gmlevel, "                 //1
-                             "sessionkey, "              //2
-                             "last_ip, "                 //3
-                             "locked, "                  //4
-                             "v, "                       //5
-                             "s, "                       //6
-                             "expansion, "               //7
-                             "mutetime, "                //8
-                             "locale "                   //9
-                             "FROM account "
-                             "WHERE username = '%s'",
-                             safe_account.c_str());
+    WorldSocketPtr this_socket = boost::static_pointer_cast<WorldSocket>(shared_from_this());
+    AuthSessionQueryHolder* holder = new AuthSessionQueryHolder(this_socket, account, clientSeed, digest);
+
+    if (recvPacket.rpos() < recvPacket.size())
+        holder->m_addonData.append(recvPacket.contents() + recvPacket.rpos(), recvPacket.size() - recvPacket.rpos());
+
+    // The lookups run on the LoginDatabase async connection, the handshake continues in HandleAuthSessionResult
+    if (!holder->Initialize(safe_account, GetRemoteAddress()) ||
+            !LoginDatabase.DelayQueryHolder(&authSessionHandler, &AuthSessionHandler::HandleAuthSessionCallback, (SqlQueryHolder*)holder))
+    {
+        delete holder;
+
+        packet.Initialize(SMSG_AUTH_RESPONSE, 1);
+        packet << uint8(AUTH_SYSTEM_ERROR);
+
+        SendPacket(packet);
+
+        sLog.outError("WorldSocket::HandleAuthSession: Sent Auth Response (account lookup failed).");
+        return false;
+    }
+
+    auth_pending_ = true;
+    return true;
+}
+
+void WorldSocket::HandleAuthSessionResult(boost::shared_ptr<AuthSessionQueryHolder> holder)
+{
+    auth_pending_ = false;
+
+    QueryResult* result = holder->GetResult(AUTH_SESSION_QUERY_ACCOUNT);
+    QueryResult* banresult = holder->GetResult(AUTH_SESSION_QUERY_BANNED);
+
+    bool authed = !IsClosed() && CompleteAuthSession(*holder, result, banresult);
+
+    delete result;
+    delete banresult;
+
+    if (!authed && !IsClosed())
+        CloseSocket();
+}
+
+bool WorldSocket::CompleteAuthSession(AuthSessionQueryHolder& holder, QueryResult* result, QueryResult* banresult)
+{
+    uint32 id, security;
+    uint8 expansion = 0;
+    LocaleConstant locale;
+    const std::string& account = holder.m_account;
+    BigNumber v, s, g, N, K;
+    WorldPacket packet;
 
     // Stop if the account is not found
     if (!result)
@@ -366,7 +671,6 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
             packet << uint8(AUTH_FAILED);
             SendPacket(packet);
 
-            delete result;
             BASIC_LOG("WorldSocket::HandleAuthSession: Sent Auth Response (Account IP differs).");
             return false;
         }
@@ -385,23 +689,12 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     if (locale >= MAX_LOCALE)
         locale = LOCALE_enUS;
 
-    delete result;
-
-    // Re-check account ban (same check as in realmd)
-    QueryResult* banresult =
-        LoginDatabase.PQuery("SELECT 1 FROM account_banned WHERE id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)"
-                             "UNION "
-                             "SELECT 1 FROM ip_banned WHERE (unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'",
-                             id, GetRemoteAddress().c_str());
-
     if (banresult) // if account banned
     {
         packet.Initialize(SMSG_AUTH_RESPONSE, 1);
         packet << uint8(AUTH_BANNED);
         SendPacket(packet);
 
-        delete banresult;
-
         sLog.outError("WorldSocket::HandleAuthSession: Sent Auth Response (Account banned).");
         return false;
     }
@@ -411,8 +704,8 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 
     if (allowedAccountType > SEC_PLAYER && AccountTypes(security) < allowedAccountType)
     {
-        WorldPacket Packet(SMSG_AUTH_RESPONSE, 1);
-        Packet << uint8(AUTH_UNAVAILABLE);
+        packet.Initialize(SMSG_AUTH_RESPONSE, 1);
+        packet << uint8(AUTH_UNAVAILABLE);
 
         SendPacket(packet);
 
@@ -425,6 +718,7 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
 
     uint32 t = 0;
     uint32 seed = seed_;
+    uint32 clientSeed = holder.m_clientSeed;
 
     sha.UpdateData(account);
     sha.UpdateData((uint8*) & t, 4);
@@ -433,7 +727,7 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     sha.UpdateBigNumbers(&K, NULL);
     sha.Finalize();
 
-    if (memcmp(sha.GetDigest(), digest, 20))
+    if (memcmp(sha.GetDigest(), holder.m_digest, 20))
     {
         packet.Initialize(SMSG_AUTH_RESPONSE, 1);
         packet << uint8(AUTH_FAILED);
@@ -458,18 +752,38 @@ bool WorldSocket::HandleAuthSession(WorldPacket& recvPacket)
     stmt.PExecute(address.c_str(), account.c_str());
 
     WorldSocketPtr this_session = boost::static_pointer_cast<WorldSocket>(shared_from_this());
-    // NOTE ATM the socket is single-threaded, have this in mind ...
-    session_ = new WorldSession(id, this_session, AccountTypes(security), expansion, mutetime, locale);
 
     crypt_.Init(&K);
 
-    session_->LoadGlobalAccountData();
-    session_->LoadTutorialsData();
-    session_->ReadAddonsInfo(recvPacket);
+    WorldSession* session = new WorldSession(id, this_session, AccountTypes(security), expansion, mutetime, locale);
+    session->ReadAddonsInfo(holder.m_addonData);
+
+    {
+        GuardType Guard(session_lock_);
+
+        // NOTE ATM the socket is single-threaded, have this in mind ...
+        session_ = session;
+    }
 
-    boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    // The account data is read on the CharacterDatabase async connection of the account,
+    // the session is added to the world by the callback
+    AccountDataQueryHolder* dataHolder = new AccountDataQueryHolder(session);
+    Database::AsyncKeyGuard asyncKey(CharacterDatabase, id);
+    if (!dataHolder->Initialize() ||
+            !CharacterDatabase.DelayQueryHolder(&accountDataHandler, &AccountDataHandler::HandleAccountDataCallback, (SqlQueryHolder*)dataHolder))
+    {
+        delete dataHolder;
 
-    sWorld.AddSession(session_);
+        {
+            GuardType Guard(session_lock_);
+            session_ = NULL;
+        }
+
+        delete session;
+
+        sLog.outError("WorldSocket::HandleAuthSession: Account data lookup failed for account %u.", id);
+        return false;
+    }
 
     return true;
 }
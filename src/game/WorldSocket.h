@@ -26,6 +26,7 @@
 #include "AuthCrypt.h"
 #include "BigNumber.h"
 #include "Socket.h"
+#include "WorldPacket.h"
 #include "ByteConverter.h"
 #include "Log.h"
 
@@ -101,6 +102,8 @@ class WorldPacket;
 class WorldSession;
 class NetworkThread;
 class WorldSocketMgr;
+class AuthSessionQueryHolder;
+class QueryResult;
 
 /**
  * WorldSocket.
@@ -141,6 +144,8 @@ class WorldSocketMgr;
 
 class WorldSocket : public Socket
 {
+    friend class AuthSessionHandler;
+
 public:
     const static int CLIENT_PACKET_HEADER_SIZE = sizeof(ClientPktHeader);
 
@@ -149,13 +154,24 @@ public:
 
     virtual void CloseSocket(void) override;
     bool SendPacket(const WorldPacket& pct);
+    // only the header is written to the socket, the payload of pct is referenced until it is sent
+    bool SendPacket(const SharedWorldPacket& pct);
     BigNumber& GetSessionKey() { return session_key_; }
 
 protected:
     virtual bool Open() override;
     virtual bool ProcessIncomingData() override;
+    virtual bool ProcessDirectReadData() override;
 
 private:
+    bool SendPacket(const WorldPacket& pct, const SharedWorldPacket* shared);
+
+    // out_buffer_lock_ must be held by the caller, returns false if the outgoing queue is full
+    bool QueuePacket(const WorldPacket& pct, const SharedWorldPacket* shared);
+    void DeferPacket(const SharedWorldPacket& pct);
+    void FlushDeferredPackets();
+    void OnOutgoingLimitReached(const WorldPacket& pct);
+
     bool ReadPacketHeader();
     bool ValidatePacketHeader();
     bool ReadPacketContent();
@@ -163,10 +179,15 @@ private:
     bool ProcessPacket(WorldPacket* new_pct);
 
     bool HandleAuthSession(WorldPacket& recvPacket);
+    void HandleAuthSessionResult(boost::shared_ptr<AuthSessionQueryHolder> holder);
+    bool CompleteAuthSession(AuthSessionQueryHolder& holder, QueryResult* result, QueryResult* banresult);
     bool HandlePing(WorldPacket& recvPacket);
 
     bool received_header_;
 
+    // CMSG_AUTH_SESSION was received, the account lookup is still running
+    bool auth_pending_;
+
     // Client packet
     ClientPktHeader header_;
     WorldPacket* packet_;
@@ -174,6 +195,12 @@ private:
     // Used for de-/encrypting packet headers
     AuthCrypt crypt_;
 
+    // Packets handed to the network thread, update packets are compressed there.
+    // Until they are queued all later packets are deferred too to keep the order.
+    typedef std::deque<SharedWorldPacket> DeferredQueue;
+    DeferredQueue deferred_;
+    bool deferred_flush_pending_;
+
     uint32 seed_;
     BigNumber session_key_;
 
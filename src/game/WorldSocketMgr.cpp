@@ -27,7 +27,7 @@
 INSTANTIATE_SINGLETON_2(WorldSocketMgr, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(WorldSocketMgr, boost::recursive_mutex);
 
-WorldSocketMgr::WorldSocketMgr() : m_SockOutKBuff(-1), m_SockOutUBuff(protocol::SEND_BUFFER_SIZE), m_UseNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : m_SockOutKBuff(-1), m_SockOutUBuff(protocol::SEND_BUFFER_SIZE), m_SockOutQueueLimit(0), m_UseNoDelay(true)
 {
     
 }
@@ -54,6 +54,10 @@ bool WorldSocketMgr::StartNetwork(boost::uint16_t port, std::string address)
         return false;
     }
 
+    // 0 means no limit
+    int outQueueLimit = sConfig.GetIntDefault("Network.OutQueueLimit", 4 * 1024 * 1024);
+    m_SockOutQueueLimit = outQueueLimit > 0 ? static_cast<size_t>(outQueueLimit) : 0;
+
     network_threads_count_ = static_cast<size_t>(sConfig.GetIntDefault("Network.Threads", 1));
 
     if (!NetworkManager::StartNetwork(port, address))
@@ -81,6 +85,7 @@ bool WorldSocketMgr::OnSocketOpen(const SocketPtr& socket)
     }
 
     socket->SetOutgoingBufferSize( static_cast<size_t>(m_SockOutUBuff));
+    socket->SetOutgoingQueueLimit(m_SockOutQueueLimit);
 
     return NetworkManager::OnSocketOpen(socket);
 }
@@ -42,6 +42,7 @@ private:
 
     int m_SockOutKBuff;
     int m_SockOutUBuff;
+    size_t m_SockOutQueueLimit;
     bool m_UseNoDelay;
 };
 
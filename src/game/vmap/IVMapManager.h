@@ -62,6 +62,10 @@ namespace VMAP
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
+            test line of sight from one position to several, results[i] is set for the target at x2[i], y2[i], z2[i]
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, const float* x2, const float* y2, const float* z2, bool* results, unsigned int count) = 0;
+            /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
             return a position, that is pReduceDist closer to the origin
             */
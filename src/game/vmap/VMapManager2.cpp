@@ -20,6 +20,7 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <algorithm>
 #include "VMapManager2.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
@@ -154,6 +155,24 @@ namespace VMAP
         }
         return result;
     }
+
+    void VMapManager2::isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, const float* x2, const float* y2, const float* z2, bool* results, unsigned int count)
+    {
+        InstanceTreeMap::iterator instanceTree = isLineOfSightCalcEnabled() ? iInstanceMapTrees.find(pMapId) : iInstanceMapTrees.end();
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            std::fill(results, results + count, true);
+            return;
+        }
+
+        // one tree lookup and origin conversion for the whole batch
+        Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            Vector3 pos2 = convertPositionToInternalRep(x2[i], y2[i], z2[i]);
+            results[i] = pos1 == pos2 || instanceTree->second->isInLineOfSight(pos1, pos2);
+        }
+    }
     //=========================================================
     /**
     get the hit position and return true if we hit something
@@ -85,6 +85,7 @@ namespace VMAP
             void unloadMap(unsigned int pMapId) override;
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) override;
+            void isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, const float* x2, const float* y2, const float* z2, bool* results, unsigned int count) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
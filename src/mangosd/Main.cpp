@@ -83,6 +83,11 @@ bool StartDatabase()
         sLog.outError("Database not specified in configuration file");
         return false;
     }
+
+    // concurrent startup loaders would otherwise wait for each other on the query connections
+    int loadingThreads = sConfig.GetIntDefault("Loading.Threads", 1);
+    if (nConnections < loadingThreads)
+        nConnections = loadingThreads;
     sLog.outString("World Database total connections: %i", nConnections + 1);
 
     // Initialise the world database
@@ -101,6 +106,7 @@ bool StartDatabase()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -109,10 +115,10 @@ bool StartDatabase()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + std::max(nAsyncConnections, 1));
 
     // Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
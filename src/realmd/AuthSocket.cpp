@@ -238,15 +238,20 @@ bool AuthSocket::SendPacket(const char* buf, size_t len)
 {
     GuardType Guard(out_buffer_lock_);
 
-    if (out_buffer_->Write((uint8*) buf, len))
+    // socket closed meanwhile
+    if (!IsOpenForSending())
+        return false;
+
+    if (!CanQueueOutgoing(len))
     {
-        StartAsyncSend();
-        return true;
+        sLog.outError("AuthSocket::SendPacket: outgoing queue limit reached for %s", GetRemoteAddress().c_str());
+        return false;
     }
-    else
-        throw std::exception("network write buffer is too small to accommodate packet");
 
-    return false;
+    QueueOutgoing((const uint8*) buf, len);
+    StartAsyncSend();
+
+    return true;
 }
 
 size_t AuthSocket::ReceivedDataLength(void) const